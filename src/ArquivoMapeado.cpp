@@ -0,0 +1,127 @@
+#include "ArquivoMapeado.h"
+#include <fstream>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Construtor
+ArquivoMapeado::ArquivoMapeado() : dados(""), gravavel(nullptr), tamanho(0), mapa(nullptr) {}
+
+// Destrutor
+ArquivoMapeado::~ArquivoMapeado() {
+    fechar();
+}
+
+// Mapeia o arquivo inteiro em memória
+bool ArquivoMapeado::abrir(const string& nomeArquivo, bool acessoSequencial) {
+    fechar();
+
+#ifndef _WIN32
+    int fd = open(nomeArquivo.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+
+    tamanho = info.st_size;
+    if (tamanho > 0) {
+        void* regiao = mmap(nullptr, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (regiao == MAP_FAILED) {
+            close(fd);
+            tamanho = 0;
+            return false;
+        }
+        madvise(regiao, tamanho, acessoSequencial ? MADV_SEQUENTIAL : MADV_WILLNEED);
+        mapa = regiao;
+        dados = static_cast<const char*>(regiao);
+    }
+
+    close(fd); // o mapeamento permanece válido
+    return true;
+#else
+    (void)acessoSequencial;
+    ifstream arquivo(nomeArquivo, ios::binary | ios::ate);
+    if (!arquivo.is_open()) {
+        return false;
+    }
+
+    tamanho = arquivo.tellg();
+    buffer.resize(tamanho + 1);
+    arquivo.seekg(0);
+    arquivo.read(buffer.data(), tamanho);
+    buffer[tamanho] = '\0';
+    dados = buffer.data();
+    return true;
+#endif
+}
+
+// Cria o arquivo e o mapeia para escrita
+bool ArquivoMapeado::criar(const string& nomeArquivo, size_t tamanhoArquivo) {
+    fechar();
+
+#ifndef _WIN32
+    int fd = open(nomeArquivo.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, (off_t)tamanhoArquivo) != 0) {
+        close(fd);
+        return false;
+    }
+
+    tamanho = tamanhoArquivo;
+    if (tamanho > 0) {
+        void* regiao = mmap(nullptr, tamanho, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (regiao == MAP_FAILED) {
+            close(fd);
+            tamanho = 0;
+            return false;
+        }
+        mapa = regiao;
+        gravavel = static_cast<char*>(regiao);
+        dados = gravavel;
+    }
+
+    close(fd);
+    return true;
+#else
+    (void)nomeArquivo;
+    (void)tamanhoArquivo;
+    return false;
+#endif
+}
+
+// Desfaz o mapeamento
+void ArquivoMapeado::fechar() {
+#ifndef _WIN32
+    if (mapa != nullptr) {
+        munmap(mapa, tamanho);
+    }
+#endif
+    mapa = nullptr;
+    gravavel = nullptr;
+    vector<char>().swap(buffer);
+    dados = "";
+    tamanho = 0;
+}
+
+const char* ArquivoMapeado::getDados() const {
+    return dados;
+}
+
+char* ArquivoMapeado::getDadosGravaveis() {
+    return gravavel;
+}
+
+size_t ArquivoMapeado::getTamanho() const {
+    return tamanho;
+}
@@ -0,0 +1,45 @@
+#ifndef ARQUIVO_MAPEADO_H
+#define ARQUIVO_MAPEADO_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+// Arquivo mapeado em memória (mmap em sistemas POSIX). Em geral somente
+// leitura; criar() mapeia um arquivo novo para escrita, usado para montar o
+// cache sem manter as arestas na memória do processo. Em sistemas sem mmap
+// o conteúdo é lido de uma vez para um buffer (e criar() não é suportado).
+class ArquivoMapeado {
+private:
+    const char* dados;
+    char* gravavel;      // mesma região, se criada por criar()
+    size_t tamanho;
+    void* mapa;          // região mapeada (nullptr se não houver)
+    vector<char> buffer; // alternativa sem mmap
+
+    ArquivoMapeado(const ArquivoMapeado&);
+    ArquivoMapeado& operator=(const ArquivoMapeado&);
+
+public:
+    ArquivoMapeado();
+    ~ArquivoMapeado();
+
+    // Mapeia o arquivo inteiro; retorna false se não for possível abri-lo.
+    // acessoSequencial orienta a leitura antecipada do sistema operacional.
+    bool abrir(const string& nomeArquivo, bool acessoSequencial = true);
+
+    // Cria (ou sobrescreve) o arquivo com o tamanho dado e o mapeia para
+    // escrita compartilhada; as alterações vão para o arquivo
+    bool criar(const string& nomeArquivo, size_t tamanhoArquivo);
+
+    // Desfaz o mapeamento
+    void fechar();
+
+    const char* getDados() const;
+    char* getDadosGravaveis();     // nullptr se não foi criado por criar()
+    size_t getTamanho() const;
+};
+
+#endif
@@ -0,0 +1,20 @@
+#include "Barreira.h"
+
+// Construtor
+Barreira::Barreira(int numThreads) : total(numThreads), aguardando(0), geracao(0) {}
+
+// Bloqueia até que todas as threads cheguem; a última libera a geração
+void Barreira::aguardar() {
+    unique_lock<mutex> guarda(trava);
+    long long minhaGeracao = geracao;
+
+    if (++aguardando == total) {
+        aguardando = 0;
+        geracao++;
+        condicao.notify_all();
+        return;
+    }
+    while (geracao == minhaGeracao) {
+        condicao.wait(guarda);
+    }
+}
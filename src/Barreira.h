@@ -0,0 +1,30 @@
+#ifndef BARREIRA_H
+#define BARREIRA_H
+
+#include <mutex>
+#include <condition_variable>
+
+using namespace std;
+
+// Barreira reutilizável para um número fixo de threads: cada chamada de
+// aguardar() bloqueia até que todas as threads a tenham chamado. Usada para
+// manter as threads vivas entre os blocos do GRASP Reativo paralelo, em vez
+// de criá-las (e alocar seu estado) a cada bloco.
+class Barreira {
+private:
+    mutex trava;
+    condition_variable condicao;
+    int total;        // threads participantes
+    int aguardando;   // threads que já chegaram na geração atual
+    long long geracao;
+
+    Barreira(const Barreira&);
+    Barreira& operator=(const Barreira&);
+
+public:
+    Barreira(int numThreads);
+
+    void aguardar();
+};
+
+#endif
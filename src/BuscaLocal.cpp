@@ -0,0 +1,284 @@
+#include "BuscaLocal.h"
+#include "ColoracaoDefeituosa.h"
+#include <algorithm>
+#include <climits>
+
+// Vértices em conflito examinados por iteração tabu (com seus vizinhos de mesma cor)
+static const int CONFLITOS_POR_ITERACAO = 16;
+static const int MAX_CANDIDATOS = 64;
+
+// Construtor
+BuscaLocal::BuscaLocal(const Grafo& g, int deficiencia, int iteracoesTabu)
+    : grafo(g), d(deficiencia), maxIteracoesTabu(iteracoesTabu), estado(g, deficiencia),
+      numCores(0), iteracaoGlobal(0) {
+    int n = grafo.getNumVertices();
+    posConflito.assign(n, -1);
+    tabuCor.assign(n, -1);
+    tabuAte.assign(n, 0);
+    marcado.assign(n, 0);
+
+    // Reserva os buffers pelo pior caso (no máximo grau máximo + 1 cores),
+    // para que aplicar() não aloque a cada solução
+    int grauMaximo = 0;
+    for (int v = 0; v < n; v++) {
+        grauMaximo = max(grauMaximo, grafo.getGrau(v));
+    }
+    vizinhosNaCor.reserve(grauMaximo + 1);
+    vizinhosNoLimite.reserve(grauMaximo + 1);
+    coresTocadas.reserve(grauMaximo + 1);
+    conflitos.reserve(n);
+    copiaCores.reserve(n);
+    candidatos.reserve(MAX_CANDIDATOS + 1);
+}
+
+// Deficiências de v acima do limite d
+int BuscaLocal::excessoVertice(int v) const {
+    return max(0, estado.getDeficiencias(v) - d);
+}
+
+// Mantém a lista de vértices em conflito
+void BuscaLocal::atualizarConflito(int v) {
+    bool emConflito = estado.getDeficiencias(v) > d;
+
+    if (emConflito && posConflito[v] < 0) {
+        posConflito[v] = conflitos.size();
+        conflitos.push_back(v);
+    } else if (!emConflito && posConflito[v] >= 0) {
+        int ultimo = conflitos.back();
+        conflitos[posConflito[v]] = ultimo;
+        posConflito[ultimo] = posConflito[v];
+        conflitos.pop_back();
+        posConflito[v] = -1;
+    }
+}
+
+// Troca a cor de v atualizando os conflitos em O(grau) (o excesso e as
+// classes são mantidos pelo estado)
+void BuscaLocal::mover(int v, int cor) {
+    int anterior = estado.getCor(v);
+    estado.recolorir(v, cor);
+
+    // Só v e seus vizinhos com a cor antiga ou a nova mudam de deficiência
+    atualizarConflito(v);
+    for (int u : grafo.getAdjacentes(v)) {
+        int c = estado.getCor(u);
+        if (u != v && (c == anterior || c == cor)) {
+            atualizarConflito(u);
+        }
+    }
+}
+
+// Avalia todas as cores para v com uma única passada pela vizinhança.
+// Ganho de mover v da cor a para a cor c:
+//   excesso novo de v - excesso atual de v
+//   - vizinhos de cor a acima de d (cada um perde uma deficiência)
+//   + vizinhos de cor c já com d ou mais (cada um ganha uma deficiência)
+int BuscaLocal::melhorCor(int v, int corExcluida, long long iteracao, long long melhorExcesso,
+                          int& delta) {
+    int atual = estado.getCor(v);
+    int lacos = 0;
+    int reducao = 0;
+
+    for (int u : grafo.getAdjacentes(v)) {
+        if (u == v) {
+            lacos++;
+            continue;
+        }
+        int c = estado.getCor(u);
+        if (c == atual) {
+            if (estado.getDeficiencias(u) > d) {
+                reducao++;
+            }
+            continue;
+        }
+        if (vizinhosNaCor[c] == 0) {
+            coresTocadas.push_back(c);
+        }
+        vizinhosNaCor[c]++;
+        if (estado.getDeficiencias(u) >= d) {
+            vizinhosNoLimite[c]++;
+        }
+    }
+
+    int excessoAtual = excessoVertice(v);
+    int escolhida = -1;
+    int empates = 0;
+
+    for (int c = 0; c < numCores; c++) {
+        if (c == atual || c == corExcluida) {
+            continue;
+        }
+        int ganho = max(0, vizinhosNaCor[c] + lacos - d) - excessoAtual - reducao +
+                    vizinhosNoLimite[c];
+
+        // Movimento tabu só é aceito se levar ao menor excesso já visto
+        bool tabu = tabuCor[v] == c && iteracao < tabuAte[v];
+        if (tabu && estado.getExcesso() + ganho >= melhorExcesso) {
+            continue;
+        }
+
+        if (escolhida == -1 || ganho < delta) {
+            escolhida = c;
+            delta = ganho;
+            empates = 1;
+        } else if (ganho == delta) {
+            empates++;
+            if (gerador.limitado(empates) == 0) {
+                escolhida = c;
+            }
+        }
+    }
+
+    for (int c : coresTocadas) {
+        vizinhosNaCor[c] = 0;
+        vizinhosNoLimite[c] = 0;
+    }
+    coresTocadas.clear();
+
+    return escolhida;
+}
+
+// Tenta esvaziar a classe informada mantendo no máximo d deficiências por vértice
+bool BuscaLocal::eliminarClasse(int classe) {
+    int n = grafo.getNumVertices();
+    copiaCores = estado.getCores();
+
+    // Redistribui os vértices da classe pelas demais cores
+    for (int v = 0; v < n; v++) {
+        if (estado.getCor(v) == classe) {
+            int delta = 0;
+            int cor = melhorCor(v, classe, iteracaoGlobal, LLONG_MAX, delta);
+            mover(v, cor);
+        }
+    }
+
+    // Busca tabu sobre o excesso
+    long long melhorExcesso = estado.getExcesso();
+    for (int iter = 0; iter < maxIteracoesTabu && estado.getExcesso() > 0; iter++) {
+        iteracaoGlobal++;
+
+        // Candidatos: alguns vértices em conflito e seus vizinhos de mesma cor
+        int numConflitos = conflitos.size();
+        int examinar = min(numConflitos, CONFLITOS_POR_ITERACAO);
+        for (int i = 0; i < examinar && (int)candidatos.size() < MAX_CANDIDATOS; i++) {
+            int w = (numConflitos <= CONFLITOS_POR_ITERACAO)
+                        ? conflitos[i]
+                        : conflitos[gerador.limitado(numConflitos)];
+            if (!marcado[w]) {
+                marcado[w] = 1;
+                candidatos.push_back(w);
+            }
+            int cor = estado.getCor(w);
+            for (int u : grafo.getAdjacentes(w)) {
+                if ((int)candidatos.size() >= MAX_CANDIDATOS) {
+                    break;
+                }
+                if (!marcado[u] && estado.getCor(u) == cor) {
+                    marcado[u] = 1;
+                    candidatos.push_back(u);
+                }
+            }
+        }
+
+        // Melhor movimento entre os candidatos
+        int melhorVertice = -1, melhorCorMov = -1, melhorDelta = 0, empates = 0;
+        for (int w : candidatos) {
+            int delta = 0;
+            int cor = melhorCor(w, classe, iteracaoGlobal, melhorExcesso, delta);
+            if (cor < 0) {
+                continue;
+            }
+            if (melhorVertice == -1 || delta < melhorDelta) {
+                melhorVertice = w;
+                melhorCorMov = cor;
+                melhorDelta = delta;
+                empates = 1;
+            } else if (delta == melhorDelta) {
+                empates++;
+                if (gerador.limitado(empates) == 0) {
+                    melhorVertice = w;
+                    melhorCorMov = cor;
+                }
+            }
+        }
+
+        for (int w : candidatos) {
+            marcado[w] = 0;
+        }
+        candidatos.clear();
+
+        if (melhorVertice < 0) {
+            continue;
+        }
+
+        // Proíbe o retorno à cor deixada por uma permanência proporcional aos conflitos
+        tabuCor[melhorVertice] = estado.getCor(melhorVertice);
+        tabuAte[melhorVertice] = iteracaoGlobal + 7 + gerador.limitado(10) + (6 * numConflitos) / 10;
+        mover(melhorVertice, melhorCorMov);
+
+        melhorExcesso = min(melhorExcesso, estado.getExcesso());
+    }
+
+    if (estado.getExcesso() > 0) {
+        // Falhou: restaura a coloração válida anterior
+        for (int v : conflitos) {
+            posConflito[v] = -1;
+        }
+        conflitos.clear();
+        estado.carregar(copiaCores);
+        // As restrições tabu não passam para a próxima solução: o resultado
+        // de aplicar() depende só da solução e da semente
+        fill(tabuAte.begin(), tabuAte.end(), 0);
+        return false;
+    }
+
+    // Sucesso: renumera as cores acima da classe eliminada
+    for (int v = 0; v < n; v++) {
+        int c = estado.getCor(v);
+        copiaCores[v] = (c > classe) ? c - 1 : c;
+    }
+    estado.carregar(copiaCores);
+    numCores--;
+    fill(tabuAte.begin(), tabuAte.end(), 0);
+    return true;
+}
+
+// Aplica a busca local enquanto conseguir eliminar classes
+bool BuscaLocal::aplicar(Solucao& sol, uint64_t semente) {
+    int n = grafo.getNumVertices();
+    gerador.semear(semente);
+
+    numCores = sol.numCores;
+    estado.carregar(sol.cores);
+    vizinhosNaCor.assign(numCores, 0);
+    vizinhosNoLimite.assign(numCores, 0);
+
+    // Só parte de soluções completas e válidas
+    for (int v = 0; v < n; v++) {
+        int c = estado.getCor(v);
+        if (c < 0 || c >= numCores || estado.getDeficiencias(v) > d) {
+            return false;
+        }
+    }
+
+    bool reduziu = false;
+    while (numCores > 1) {
+        int menor = 0;
+        for (int c = 1; c < numCores; c++) {
+            if (estado.getTamanhoClasse(c) < estado.getTamanhoClasse(menor)) {
+                menor = c;
+            }
+        }
+        if (!eliminarClasse(menor)) {
+            break;
+        }
+        reduziu = true;
+    }
+
+    if (reduziu) {
+        sol.cores = estado.getCores();
+        sol.numCores = numCores;
+        sol.numDeficiencias = estado.totalDeficiencias();
+    }
+    return reduziu;
+}
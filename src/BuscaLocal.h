@@ -0,0 +1,66 @@
+#ifndef BUSCA_LOCAL_H
+#define BUSCA_LOCAL_H
+
+#include "Grafo.h"
+#include "EstadoColoracao.h"
+#include "GeradorAleatorio.h"
+#include <vector>
+
+using namespace std;
+
+struct Solucao;
+
+// Busca local para reduzir o número de cores de uma solução válida.
+// Cada tentativa esvazia a menor classe de cor, movendo seus vértices para
+// as demais classes, e então aplica uma busca tabu sobre o excesso
+// (soma, sobre os vértices, das deficiências acima de d) até zerá-lo.
+// Movimentos trocam a cor de um vértice; o ganho de cada movimento é
+// calculado de forma incremental a partir das deficiências mantidas pelo
+// EstadoColoracao, que mantém também o excesso e o tamanho das classes.
+// Um vértice não pode voltar à cor que acabou de deixar durante a
+// permanência tabu, exceto se o movimento gerar o menor excesso já visto
+// (aspiração). Se a tentativa falha, a solução anterior é mantida.
+class BuscaLocal {
+private:
+    const Grafo& grafo;
+    int d;
+    int maxIteracoesTabu;        // iterações tabu por tentativa
+
+    EstadoColoracao estado;
+    GeradorAleatorio gerador;
+    int numCores;
+    vector<int> conflitos;       // vértices com mais de d deficiências
+    vector<int> posConflito;     // posição em conflitos (-1 se ausente)
+    vector<int> tabuCor;         // cor que v não pode retomar
+    vector<long long> tabuAte;   // iteração até a qual a restrição vale
+    long long iteracaoGlobal;    // contador de iterações tabu
+    vector<int> copiaCores;      // coloração válida antes da tentativa
+
+    // Rascunho por cor para avaliar os movimentos de um vértice
+    vector<int> vizinhosNaCor;   // vizinhos com a cor c
+    vector<int> vizinhosNoLimite; // vizinhos com a cor c e d ou mais deficiências
+    vector<int> coresTocadas;
+    vector<int> candidatos;
+    vector<char> marcado;
+
+    int excessoVertice(int v) const;
+    void atualizarConflito(int v);
+    void mover(int v, int cor);
+
+    // Melhor cor (diferente da atual e de corExcluida) para v e seu ganho
+    int melhorCor(int v, int corExcluida, long long iteracao, long long melhorExcesso,
+                  int& delta);
+
+    // Tenta eliminar a classe de cor informada
+    bool eliminarClasse(int classe);
+
+public:
+    BuscaLocal(const Grafo& g, int deficiencia, int iteracoesTabu);
+
+    // Aplica a busca local a uma solução válida (sol.cores, sol.numCores).
+    // Retorna true se o número de cores foi reduzido (e então atualiza
+    // também sol.numDeficiencias).
+    bool aplicar(Solucao& sol, uint64_t semente);
+};
+
+#endif
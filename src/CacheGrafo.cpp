@@ -0,0 +1,290 @@
+#include "CacheGrafo.h"
+#include "ArquivoMapeado.h"
+#include "LeitorInstancia.h"
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <atomic>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+static const char MAGICA[8] = {'C', 'D', 'G', 'R', 'A', 'F', 'O', '\0'};
+static const uint32_t VERSAO_CACHE = 2; // 2: linhas ordenadas, sem laços nem repetições
+
+// Vizinhos gravados por releitura do texto na montagem semi-externa (256 MB):
+// limita as páginas sujas do mapeamento a um trecho contíguo por passada
+static const long long JANELA_VIZINHOS = (256LL << 20) / sizeof(int32_t);
+
+// Cabeçalho do cache binário (72 bytes, alinhado a 8)
+struct CabecalhoCache {
+    char magica[8];
+    uint32_t versao;
+    uint32_t reservado;
+    int64_t numVertices;
+    int64_t numArestas;
+    int64_t numAdjacencias;   // 2m
+    int64_t tamanhoOrigem;    // tamanho do arquivo texto
+    int64_t modificacaoOrigem; // data de modificação do arquivo texto
+    int64_t problemasLeitura; // problemas de formato encontrados no texto
+    uint64_t checksum;        // dos deslocamentos e vizinhos
+};
+
+// Checksum de 64 bits em blocos de 8 bytes (mistura multiplicativa)
+static uint64_t calcularChecksum(const char* dados, size_t tamanho, uint64_t h) {
+    const uint64_t primo = 0x100000001b3ULL;
+    size_t i = 0;
+    for (; i + 8 <= tamanho; i += 8) {
+        uint64_t palavra;
+        memcpy(&palavra, dados + i, 8);
+        h = (h ^ palavra) * primo;
+        h ^= h >> 29;
+    }
+    for (; i < tamanho; i++) {
+        h = (h ^ (unsigned char)dados[i]) * primo;
+    }
+    return h;
+}
+
+// Temporário no diretório do destino, único por processo e por chamada:
+// execuções simultâneas sobre a mesma instância não gravam no mesmo arquivo
+static string caminhoTemporario(const string& destino) {
+    static atomic<unsigned long> contador(0);
+    ostringstream nome;
+#ifdef _WIN32
+    nome << destino << "." << _getpid();
+#else
+    nome << destino << "." << getpid();
+#endif
+    nome << "." << contador++ << ".tmp";
+    return nome.str();
+}
+
+// Publica o temporário como cache; no POSIX rename troca o destino de forma
+// atômica, sem um intervalo em que o cache não existe
+static bool publicar(const string& temporario, const string& destino) {
+#ifdef _WIN32
+    remove(destino.c_str()); // rename não sobrescreve no Windows
+#endif
+    if (rename(temporario.c_str(), destino.c_str()) != 0) {
+        remove(temporario.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Tamanho e data de modificação do arquivo texto
+bool CacheGrafo::carimboOrigem(const string& arquivo, int64_t& tamanho, int64_t& modificacao) {
+    struct stat info;
+    if (stat(arquivo.c_str(), &info) != 0) {
+        return false;
+    }
+    tamanho = info.st_size;
+#ifdef __linux__
+    modificacao = (int64_t)info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec;
+#else
+    modificacao = info.st_mtime;
+#endif
+    return true;
+}
+
+// Caminho do cache de uma instância
+string CacheGrafo::caminhoCache(const string& arquivoInstancia) {
+    return arquivoInstancia + ".csr";
+}
+
+// Carrega o grafo do cache, se válido
+Grafo* CacheGrafo::carregar(const string& arquivoInstancia, RelatorioLeitura& relatorio,
+                            bool semiExterno) {
+    int64_t tamanhoOrigem, modificacaoOrigem;
+    if (!carimboOrigem(arquivoInstancia, tamanhoOrigem, modificacaoOrigem)) {
+        return nullptr;
+    }
+
+    ArquivoMapeado* mapa = new ArquivoMapeado();
+    if (!mapa->abrir(caminhoCache(arquivoInstancia), semiExterno) ||
+        mapa->getTamanho() < sizeof(CabecalhoCache)) {
+        delete mapa;
+        return nullptr;
+    }
+
+    CabecalhoCache cab;
+    memcpy(&cab, mapa->getDados(), sizeof(cab));
+
+    // Cabeçalho compatível e arquivo texto inalterado
+    bool valido = memcmp(cab.magica, MAGICA, sizeof(MAGICA)) == 0 &&
+                  cab.versao == VERSAO_CACHE &&
+                  cab.tamanhoOrigem == tamanhoOrigem &&
+                  cab.modificacaoOrigem == modificacaoOrigem &&
+                  cab.numVertices >= 0 && cab.numVertices <= INT32_MAX &&
+                  cab.numArestas >= 0 &&
+                  cab.numAdjacencias >= 0;
+
+    size_t bytesInicio = 0, bytesVizinhos = 0;
+    if (valido) {
+        bytesInicio = (size_t)(cab.numVertices + 1) * sizeof(int64_t);
+        bytesVizinhos = (size_t)cab.numAdjacencias * sizeof(int32_t);
+        valido = mapa->getTamanho() == sizeof(cab) + bytesInicio + bytesVizinhos;
+    }
+    if (valido) {
+        const char* corpo = mapa->getDados() + sizeof(cab);
+        valido = calcularChecksum(corpo, bytesInicio + bytesVizinhos, 0xcbf29ce484222325ULL) ==
+                 cab.checksum;
+    }
+    if (!valido) {
+        delete mapa;
+        return nullptr;
+    }
+
+    const char* corpo = mapa->getDados() + sizeof(cab);
+    const long long* inicio = reinterpret_cast<const long long*>(corpo);
+    const int* vizinhos = reinterpret_cast<const int*>(corpo + bytesInicio);
+
+    relatorio = RelatorioLeitura();
+    relatorio.sucesso = true;
+    relatorio.lidoDoCache = true;
+    relatorio.arestasLidas = cab.numArestas;
+    relatorio.totalProblemas = cab.problemasLeitura; // detalhes só na leitura do texto
+
+    return new Grafo((int)cab.numVertices, cab.numArestas, mapa, inicio, vizinhos,
+                     !semiExterno);
+}
+
+// Grava o cache (em arquivo temporário renomeado ao final)
+bool CacheGrafo::salvar(const Grafo& g, const string& arquivoInstancia, long long problemasLeitura) {
+    if (!g.estaCongelado()) {
+        return false;
+    }
+
+    CabecalhoCache cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magica, MAGICA, sizeof(MAGICA));
+    cab.versao = VERSAO_CACHE;
+    if (!carimboOrigem(arquivoInstancia, cab.tamanhoOrigem, cab.modificacaoOrigem)) {
+        return false;
+    }
+
+    int n = g.getNumVertices();
+    const long long* inicio = g.getInicioVizinhos();
+    cab.numVertices = n;
+    cab.numArestas = g.getNumArestas();
+    cab.numAdjacencias = inicio[n];
+    cab.problemasLeitura = problemasLeitura;
+
+    const char* bytesInicio = reinterpret_cast<const char*>(inicio);
+    const char* bytesVizinhos = reinterpret_cast<const char*>(g.getVizinhos());
+    size_t tamInicio = (size_t)(n + 1) * sizeof(int64_t);
+    size_t tamVizinhos = (size_t)inicio[n] * sizeof(int32_t);
+
+    cab.checksum = calcularChecksum(bytesInicio, tamInicio, 0xcbf29ce484222325ULL);
+    // Continua o checksum como se os dois blocos fossem contíguos: tamInicio é múltiplo de 8
+    cab.checksum = calcularChecksum(bytesVizinhos, tamVizinhos, cab.checksum);
+
+    string destino = caminhoCache(arquivoInstancia);
+    string temporario = caminhoTemporario(destino);
+    ofstream arquivo(temporario, ios::binary | ios::trunc);
+    if (!arquivo.is_open()) {
+        return false;
+    }
+
+    arquivo.write(reinterpret_cast<const char*>(&cab), sizeof(cab));
+    arquivo.write(bytesInicio, tamInicio);
+    arquivo.write(bytesVizinhos, tamVizinhos);
+    arquivo.close();
+
+    if (!arquivo) {
+        remove(temporario.c_str());
+        return false;
+    }
+    return publicar(temporario, destino);
+}
+
+// Monta o cache a partir do texto com memória O(n)
+bool CacheGrafo::construirExterno(const string& arquivoInstancia, RelatorioLeitura& relatorio) {
+    CabecalhoCache cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magica, MAGICA, sizeof(MAGICA));
+    cab.versao = VERSAO_CACHE;
+    if (!carimboOrigem(arquivoInstancia, cab.tamanhoOrigem, cab.modificacaoOrigem)) {
+        relatorio = RelatorioLeitura();
+        relatorio.registrar(0, "erro ao abrir arquivo");
+        return false;
+    }
+
+    // Única estrutura proporcional ao grafo mantida na memória: n + 1 deslocamentos
+    vector<long long> inicio;
+    if (!LeitorInstancia::contarGraus(arquivoInstancia, inicio, relatorio)) {
+        return false;
+    }
+    int n = (int)inicio.size() - 1;
+    size_t tamInicio = (size_t)(n + 1) * sizeof(int64_t);
+    size_t tamVizinhos = (size_t)inicio[n] * sizeof(int32_t);
+
+    string destino = caminhoCache(arquivoInstancia);
+    string temporario = caminhoTemporario(destino);
+    ArquivoMapeado saida;
+    if (!saida.criar(temporario, sizeof(cab) + tamInicio + tamVizinhos)) {
+        relatorio.registrar(0, "erro ao criar " + temporario);
+        remove(temporario.c_str());
+        return false;
+    }
+
+    // Os vizinhos vão direto para o arquivo, uma janela de vértices por vez
+    // (escritas num trecho limitado, não espalhadas pelo mapeamento); as linhas
+    // são normalizadas no lugar, o que só encurta o bloco de vizinhos
+    char* corpo = saida.getDadosGravaveis() + sizeof(cab);
+    int* vizinhos = reinterpret_cast<int*>(corpo + tamInicio);
+    if (!LeitorInstancia::preencherVizinhos(arquivoInstancia, inicio, vizinhos, JANELA_VIZINHOS)) {
+        relatorio.registrar(0, "erro ao reler arquivo");
+        saida.fechar();
+        remove(temporario.c_str());
+        return false;
+    }
+    long long distintas = Grafo::normalizarCSR(n, inicio.data(), vizinhos,
+                                               relatorio.lacos, relatorio.arestasRepetidas);
+    relatorio.totalProblemas += relatorio.lacos + relatorio.arestasRepetidas;
+    relatorio.arestasLidas = distintas;
+
+    memcpy(corpo, inicio.data(), tamInicio);
+    tamVizinhos = (size_t)inicio[n] * sizeof(int32_t);
+
+    cab.numVertices = n;
+    cab.numArestas = distintas;
+    cab.numAdjacencias = inicio[n];
+    cab.problemasLeitura = relatorio.totalProblemas;
+    cab.checksum = calcularChecksum(corpo, tamInicio + tamVizinhos, 0xcbf29ce484222325ULL);
+    memcpy(saida.getDadosGravaveis(), &cab, sizeof(cab));
+    saida.fechar();
+
+    // Descarta a cauda liberada pela compactação (criar() só existe com mmap)
+#ifndef _WIN32
+    if (truncate(temporario.c_str(), (off_t)(sizeof(cab) + tamInicio + tamVizinhos)) != 0) {
+        remove(temporario.c_str());
+        return false;
+    }
+#endif
+    return publicar(temporario, destino);
+}
+
+// Carga no modo semi-externo
+Grafo* CacheGrafo::carregarExterno(const string& arquivoInstancia, RelatorioLeitura& relatorio) {
+    Grafo* g = carregar(arquivoInstancia, relatorio, true);
+    if (g != nullptr) {
+        return g;
+    }
+
+    if (!construirExterno(arquivoInstancia, relatorio)) {
+        return nullptr;
+    }
+
+    // Mantém os detalhes dos problemas encontrados na leitura do texto
+    RelatorioLeitura doCache;
+    g = carregar(arquivoInstancia, doCache, true);
+    relatorio.sucesso = (g != nullptr);
+    return g;
+}
@@ -0,0 +1,47 @@
+#ifndef CACHE_GRAFO_H
+#define CACHE_GRAFO_H
+
+#include "Grafo.h"
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+// Cache binário de instâncias, gravado ao lado do arquivo texto
+// ("<instancia>.csr"). Formato (ordem de bytes da máquina):
+//   cabeçalho de 72 bytes (mágica, versão, n, m, 2m, tamanho e data de
+//   modificação do arquivo texto, problemas de leitura, checksum);
+//   n + 1 deslocamentos de 64 bits;
+//   2m vizinhos de 32 bits.
+// Na carga o arquivo é mapeado em memória e o grafo usa os vetores
+// diretamente do mapeamento, sem cópia. O cache é descartado se o arquivo
+// texto mudou (tamanho ou data), se a versão difere ou se o checksum falha.
+class CacheGrafo {
+public:
+    // Caminho do cache de uma instância
+    static string caminhoCache(const string& arquivoInstancia);
+
+    // Tamanho e data de modificação (ns) de um arquivo; false se não existe
+    static bool carimboOrigem(const string& arquivo, int64_t& tamanho, int64_t& modificacao);
+
+    // Carrega o grafo do cache se ele for válido para a instância; senão nullptr.
+    // semiExterno: o mapeamento é lido sequencialmente, sob demanda, e a
+    // matriz de bits dos grafos densos não é construída.
+    static Grafo* carregar(const string& arquivoInstancia, RelatorioLeitura& relatorio,
+                           bool semiExterno = false);
+
+    // Grava o cache do grafo (congelado); retorna false se não foi possível
+    static bool salvar(const Grafo& g, const string& arquivoInstancia, long long problemasLeitura);
+
+    // Monta o cache direto do arquivo texto, sem carregar as arestas na
+    // memória do processo: os graus (O(n)) são contados numa passada, os
+    // vizinhos são gravados num mapeamento do próprio arquivo de cache e as
+    // linhas são ordenadas e compactadas ali mesmo.
+    static bool construirExterno(const string& arquivoInstancia, RelatorioLeitura& relatorio);
+
+    // Modo semi-externo: usa o cache se válido, senão o constrói com
+    // construirExterno, e o carrega com semiExterno = true
+    static Grafo* carregarExterno(const string& arquivoInstancia, RelatorioLeitura& relatorio);
+};
+
+#endif
@@ -0,0 +1,108 @@
+#include "CacheInstancias.h"
+#include "CacheGrafo.h"
+#include "LeitorInstancia.h"
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+
+CacheInstancias::CacheInstancias(int capacidade, bool usarCacheBinario, bool calcularLimite)
+    : capacidade(max(capacidade, 1)), usarCacheBinario(usarCacheBinario),
+      calcularLimite(calcularLimite), acertos(0), faltas(0), descartes(0) {}
+
+// Instância do cache ou lida agora
+shared_ptr<InstanciaCarregada> CacheInstancias::obter(const string& caminho, bool& acerto,
+                                                      string& erro) {
+    acerto = false;
+    int64_t tamanho, modificacao;
+    if (!CacheGrafo::carimboOrigem(caminho, tamanho, modificacao)) {
+        erro = "instancia inexistente: " + caminho;
+        return nullptr;
+    }
+
+    unique_lock<mutex> guarda(trava);
+    while (true) {
+        auto it = entradas.find(caminho);
+        if (it == entradas.end()) {
+            break;
+        }
+        Entrada& e = it->second;
+        if (!e.pronta) {
+            // Outra thread está lendo o arquivo: espera e consulta de novo
+            carregou.wait(guarda);
+            continue;
+        }
+        if (e.tamanho != tamanho || e.modificacao != modificacao) {
+            // O arquivo mudou desde a carga
+            uso.erase(e.posicao);
+            entradas.erase(it);
+            descartes++;
+            break;
+        }
+        acertos++;
+        acerto = true;
+        uso.splice(uso.begin(), uso, e.posicao);
+        return e.instancia;
+    }
+
+    // Falta: reserva a entrada e lê o arquivo fora da trava
+    faltas++;
+    uso.push_front(caminho);
+    Entrada& nova = entradas[caminho];
+    nova.tamanho = tamanho;
+    nova.modificacao = modificacao;
+    nova.pronta = false;
+    nova.posicao = uso.begin();
+    guarda.unlock();
+
+    auto inicio = chrono::steady_clock::now();
+    shared_ptr<InstanciaCarregada> instancia(new InstanciaCarregada());
+    RelatorioLeitura relatorio;
+    instancia->grafo = Grafo::lerArquivo(caminho, relatorio, usarCacheBinario);
+    if (relatorio.temProblemas()) {
+        relatorio.imprimir(cerr, caminho);
+    }
+    if (instancia->grafo != nullptr && calcularLimite) {
+        instancia->limite = new LimiteInferior(*instancia->grafo);
+    }
+    instancia->tempoCarga = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+    // Entradas em leitura não são retiradas por outras threads
+    guarda.lock();
+    auto it = entradas.find(caminho);
+    if (instancia->grafo == nullptr) {
+        uso.erase(it->second.posicao);
+        entradas.erase(it);
+        carregou.notify_all();
+        erro = "erro ao carregar instancia " + caminho;
+        return nullptr;
+    }
+    it->second.instancia = instancia;
+    it->second.pronta = true;
+    descartarExcedentes();
+    carregou.notify_all();
+    return instancia;
+}
+
+// Retira as menos usadas, do fim da lista de uso, pulando as em leitura
+void CacheInstancias::descartarExcedentes() {
+    auto it = uso.end();
+    while (entradas.size() > capacidade && it != uso.begin()) {
+        --it;
+        auto entrada = entradas.find(*it);
+        if (!entrada->second.pronta) {
+            continue;
+        }
+        entradas.erase(entrada);
+        it = uso.erase(it);
+        descartes++;
+    }
+}
+
+string CacheInstancias::descrever() {
+    lock_guard<mutex> guarda(trava);
+    ostringstream texto;
+    texto << "grafos=" << entradas.size() << " capacidade=" << capacidade << " acertos=" << acertos
+          << " faltas=" << faltas << " descartes=" << descartes;
+    return texto.str();
+}
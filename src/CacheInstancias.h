@@ -0,0 +1,83 @@
+#ifndef CACHE_INSTANCIAS_H
+#define CACHE_INSTANCIAS_H
+
+#include "Grafo.h"
+#include "LimiteInferior.h"
+#include <string>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+using namespace std;
+
+// Instância carregada na memória: o grafo congelado e, se calculados, os
+// invariantes do seu limite inferior. Compartilhada só para leitura pelas
+// execuções; liberada quando sai do cache e a última execução termina.
+struct InstanciaCarregada {
+    Grafo* grafo;
+    LimiteInferior* limite;     // nullptr sem o limite inferior
+    double tempoCarga;          // segundos de leitura (e do limite)
+
+    InstanciaCarregada() : grafo(nullptr), limite(nullptr), tempoCarga(0.0) {}
+    ~InstanciaCarregada() {
+        delete limite;
+        delete grafo;
+    }
+
+private:
+    InstanciaCarregada(const InstanciaCarregada&);
+    InstanciaCarregada& operator=(const InstanciaCarregada&);
+};
+
+// Cache LRU das instâncias já lidas pelo modo serviço (--servico), por
+// caminho do arquivo; cada entrada guarda o tamanho e a data de modificação
+// do arquivo na carga, e uma entrada cujo arquivo mudou é descartada e lida
+// de novo. Ao passar de capacidade entradas, sai a usada há mais tempo.
+//
+// Várias threads podem pedir a mesma instância ao mesmo tempo: a primeira
+// a lê (fora da trava) e as demais esperam por ela, sem leituras repetidas.
+// As entradas são shared_ptr: uma instância descartada continua válida
+// para as execuções que ainda a usam.
+class CacheInstancias {
+private:
+    struct Entrada {
+        int64_t tamanho;
+        int64_t modificacao;
+        bool pronta;                        // false enquanto é lida
+        shared_ptr<InstanciaCarregada> instancia;
+        list<string>::iterator posicao;     // na lista de uso
+    };
+
+    size_t capacidade;
+    bool usarCacheBinario;
+    bool calcularLimite;
+
+    mutex trava;
+    condition_variable carregou;
+    map<string, Entrada> entradas;
+    list<string> uso;                       // da usada mais recentemente à mais antiga
+    long long acertos;
+    long long faltas;
+    long long descartes;
+
+    // Retira as entradas prontas menos usadas além da capacidade (com a trava)
+    void descartarExcedentes();
+
+    CacheInstancias(const CacheInstancias&);
+    CacheInstancias& operator=(const CacheInstancias&);
+
+public:
+    CacheInstancias(int capacidade, bool usarCacheBinario, bool calcularLimite);
+
+    // Instância do arquivo, do cache ou lida agora (acerto indica qual);
+    // nullptr se não pôde ser carregada, com o motivo em erro
+    shared_ptr<InstanciaCarregada> obter(const string& caminho, bool& acerto, string& erro);
+
+    // Resumo em uma linha: entradas, acertos, faltas e descartes
+    string descrever();
+};
+
+#endif
@@ -0,0 +1,75 @@
+#include "CasamentoCores.h"
+#include <algorithm>
+
+using namespace std;
+
+// Casa as classes de a com as de b pela maior sobreposição
+int CasamentoCores::casar(const vector<int>& a, int ka, const vector<int>& b, int kb,
+                          vector<int>& correspondencia) {
+    int n = a.size();
+    lista.clear();
+
+    // Sobreposição de cada par de classes: pela matriz se ela não passa de
+    // O(n) células, senão ordenando os pares
+    if ((long long)ka * kb <= 4LL * n) {
+        matriz.assign((size_t)ka * kb, 0);
+        for (int v = 0; v < n; v++) {
+            matriz[(size_t)a[v] * kb + b[v]]++;
+        }
+        for (int ca = 0; ca < ka; ca++) {
+            for (int cb = 0; cb < kb; cb++) {
+                int vertices = matriz[(size_t)ca * kb + cb];
+                if (vertices > 0) {
+                    lista.push_back({vertices, ca, cb});
+                }
+            }
+        }
+    } else {
+        pares.resize(n);
+        for (int v = 0; v < n; v++) {
+            pares[v] = (long long)a[v] * kb + b[v];
+        }
+        sort(pares.begin(), pares.end());
+        for (int i = 0; i < n; ) {
+            int j = i;
+            while (j < n && pares[j] == pares[i]) {
+                j++;
+            }
+            lista.push_back({j - i, (int)(pares[i] / kb), (int)(pares[i] % kb)});
+            i = j;
+        }
+    }
+
+    // Guloso pela sobreposição decrescente (desempate pelas cores: determinístico)
+    sort(lista.begin(), lista.end(), [](const Sobreposicao& x, const Sobreposicao& y) {
+        if (x.vertices != y.vertices) {
+            return x.vertices > y.vertices;
+        }
+        return x.ca < y.ca || (x.ca == y.ca && x.cb < y.cb);
+    });
+
+    correspondencia.assign(ka, -1);
+    usadaB.assign(kb, 0);
+    int concordantes = 0;
+    for (const Sobreposicao& s : lista) {
+        if (correspondencia[s.ca] < 0 && !usadaB[s.cb]) {
+            correspondencia[s.ca] = s.cb;
+            usadaB[s.cb] = 1;
+            concordantes += s.vertices;
+        }
+    }
+
+    // Classes sem par recebem rótulos novos
+    int proxima = kb;
+    for (int ca = 0; ca < ka; ca++) {
+        if (correspondencia[ca] < 0) {
+            correspondencia[ca] = proxima++;
+        }
+    }
+    return concordantes;
+}
+
+// Distância de Hamming após o casamento
+int CasamentoCores::distancia(const vector<int>& a, int ka, const vector<int>& b, int kb) {
+    return (int)a.size() - casar(a, ka, b, kb, correspondenciaDistancia);
+}
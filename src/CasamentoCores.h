@@ -0,0 +1,44 @@
+#ifndef CASAMENTO_CORES_H
+#define CASAMENTO_CORES_H
+
+#include <vector>
+
+using namespace std;
+
+// Casamento das classes de cor de duas colorações do mesmo grafo. Os
+// rótulos das cores são arbitrários (trocar duas cores não muda a
+// solução), então a distância entre colorações é a de Hamming depois de
+// renomear as classes de uma para as da outra: cada classe de a recebe a
+// cor de b com que mais se sobrepõe (guloso pela sobreposição decrescente,
+// cada cor de b usada uma vez). Classes de a sem par recebem rótulos novos,
+// a partir de kb.
+//
+// A sobreposição é contada numa matriz ka x kb quando ela tem O(n)
+// células e, nos demais casos, ordenando os pares (cor em a, cor em b) dos
+// vértices.
+// Os buffers são reaproveitados entre chamadas (um objeto por thread).
+class CasamentoCores {
+private:
+    struct Sobreposicao {
+        int vertices;   // vértices com a cor ca em a e cb em b
+        int ca, cb;
+    };
+
+    vector<int> matriz;            // contagem ka x kb (quando cabe)
+    vector<long long> pares;       // pares ca * kb + cb (caso geral)
+    vector<Sobreposicao> lista;    // pares com sobreposição positiva
+    vector<char> usadaB;
+    vector<int> correspondenciaDistancia;
+
+public:
+    // Preenche correspondencia[ca] = cor atribuída à classe ca de a.
+    // Retorna o número de vértices em que as colorações concordam após o
+    // casamento (a distância é n menos esse valor).
+    int casar(const vector<int>& a, int ka, const vector<int>& b, int kb,
+              vector<int>& correspondencia);
+
+    // Distância de Hamming entre a e b após o casamento das classes
+    int distancia(const vector<int>& a, int ka, const vector<int>& b, int kb);
+};
+
+#endif
@@ -1,26 +1,176 @@
 #include "ColoracaoDefeituosa.h"
+#include "EstadoColoracao.h"
+#include "FilaCandidatos.h"
+#include "BuscaLocal.h"
+#include "PoolElite.h"
+#include "ReligacaoCaminhos.h"
+#include "Decomposicao.h"
+#include "PoolTarefas.h"
+#include "Barreira.h"
+#include "EscritorAssincrono.h"
 #include <algorithm>
-#include <random>
 #include <ctime>
 #include <chrono>
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <sstream>
 #include <map>
+#include <climits>
+#include <thread>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
 
 using namespace std;
 
+// Religação de caminhos: distância mínima entre soluções da elite (fração
+// dos vértices), fração do orçamento de tempo (--tempo) reservada a ela,
+// iterações tabu da busca local aplicada às intermediárias quando
+// --busca-local não foi dado, e primeiro fluxo aleatório dos pares (longe
+// dos fluxos das iterações)
+static const double DIVERSIDADE_ELITE = 0.01;
+static const double FRACAO_TEMPO_RELIGACAO = 0.2;
+static const int ITERACOES_TABU_RELIGACAO = 100;
+static const uint64_t FLUXO_RELIGACAO = 1ULL << 32;
+
 // Construtor
 ColoracaoDefeituosa::ColoracaoDefeituosa(const Grafo& g, int deficiencia) 
-    : grafo(g), d(deficiencia) {}
+    : grafo(g), d(deficiencia), numThreads(1), semente(0), iteracoesBuscaLocal(0),
+      silencioso(false), construcao(CONSTRUCAO_GRAU), reordenacao(REORDENACAO_NENHUMA),
+      tamanhoElite(0), limiteInferior(0), separarComponentes(false),
+      podarVertices(false) {}
+
+// Número de threads usadas pelo GRASP / Reativo (1 = execução serial)
+void ColoracaoDefeituosa::setNumThreads(int threads) {
+    numThreads = max(threads, 1);
+}
+
+// Semente dos fluxos aleatórios: a iteração i usa o fluxo i + 1 e a roleta
+// dos alphas do Reativo o fluxo 0, com qualquer número de threads
+void ColoracaoDefeituosa::setSemente(unsigned int s) {
+    semente = s;
+}
+
+// Suprime os relatórios intermediários impressos pelos algoritmos
+void ColoracaoDefeituosa::setSilencioso(bool s) {
+    silencioso = s;
+}
+
+// Renumeração aplicada ao grafo e identificadores originais dos vértices
+void ColoracaoDefeituosa::setReordenacao(Reordenacao r, const vector<int>& rotulos) {
+    reordenacao = r;
+    if (r == REORDENACAO_NENHUMA) {
+        rotulosOriginais.clear();
+    } else {
+        rotulosOriginais = rotulos;
+    }
+}
+
+// cores[rotulos[v]] = cor do vértice interno v
+void ColoracaoDefeituosa::restaurarRotulos(Solucao& sol) const {
+    if (rotulosOriginais.empty() || sol.cores.empty()) {
+        return;
+    }
+    vector<int> cores(sol.cores.size());
+    for (size_t v = 0; v < sol.cores.size(); v++) {
+        cores[rotulosOriginais[v]] = sol.cores[v];
+    }
+    sol.cores.swap(cores);
+}
+
+// Critérios de parada antecipada do GRASP e do Reativo
+void ColoracaoDefeituosa::setCriterioParada(const CriterioParada& c) {
+    criterioParada = c;
+}
+
+// Limite inferior calculado para a instância (LimiteInferior; 0 = desconhecido)
+void ColoracaoDefeituosa::setLimiteInferior(int limite) {
+    limiteInferior = max(limite, 0);
+}
+
+// Tamanho da elite do GRASP / Reativo (0 desliga a religação de caminhos)
+void ColoracaoDefeituosa::setElite(int tamanho) {
+    tamanhoElite = max(tamanho, 0);
+}
+
+// Decomposição do grafo (componentes conexos e/ou poda)
+void ColoracaoDefeituosa::setDecomposicao(bool componentes, bool podar) {
+    separarComponentes = componentes;
+    podarVertices = podar;
+}
+
+// Nome da decomposição na coluna Decomposicao do CSV
+string ColoracaoDefeituosa::nomeDecomposicao() const {
+    if (separarComponentes && podarVertices) {
+        return "componentes+poda";
+    }
+    if (separarComponentes) {
+        return "componentes";
+    }
+    return podarVertices ? "poda" : "nenhuma";
+}
+
+// Ordem dos vértices na construção do GRASP / Reativo
+void ColoracaoDefeituosa::setConstrucao(Construcao c) {
+    construcao = c;
+}
 
-// Calcula o número total de deficiências na solução
+// Construção pelo nome usado na linha de comando
+bool ColoracaoDefeituosa::lerConstrucao(const string& nome, Construcao& c) {
+    if (nome == "grau") {
+        c = CONSTRUCAO_GRAU;
+    } else if (nome == "dsatur") {
+        c = CONSTRUCAO_DSATUR;
+    } else if (nome == "smallestlast") {
+        c = CONSTRUCAO_SMALLEST_LAST;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+string ColoracaoDefeituosa::nomeConstrucao(Construcao c) {
+    switch (c) {
+        case CONSTRUCAO_DSATUR:
+            return "dsatur";
+        case CONSTRUCAO_SMALLEST_LAST:
+            return "smallestlast";
+        default:
+            return "grau";
+    }
+}
+
+// Liga a busca local (iterações tabu por tentativa; 0 desliga)
+void ColoracaoDefeituosa::setBuscaLocal(int iteracoesTabu) {
+    iteracoesBuscaLocal = max(iteracoesTabu, 0);
+}
+
+// Cria a busca local da execução, ou nullptr se desligada
+BuscaLocal* ColoracaoDefeituosa::criarBuscaLocal() {
+    if (iteracoesBuscaLocal <= 0) {
+        return nullptr;
+    }
+    return new BuscaLocal(grafo, d, iteracoesBuscaLocal);
+}
+
+// Aplica a busca local (se houver); ela mesma atualiza as deficiências
+void ColoracaoDefeituosa::melhorarSolucao(Solucao& sol, BuscaLocal* busca, uint64_t sementeBusca) {
+    INSTR_FASE(FASE_BUSCA_LOCAL);
+    if (busca != nullptr) {
+        busca->aplicar(sol, sementeBusca);
+    }
+}
+
+// Calcula o número total de deficiências na solução por uma varredura
+// completa das arestas (só para conferência: ver verificarAvaliacao)
 int ColoracaoDefeituosa::calcularDeficiencias(const vector<int>& cores) {
+    INSTR_FASE(FASE_AVALIACAO);
     int totalDeficiencias = 0;
     int n = grafo.getNumVertices();
     
     for (int v = 0; v < n; v++) {
-        const vector<int>& vizinhos = grafo.getAdjacentes(v);
+        Vizinhanca vizinhos = grafo.getAdjacentes(v);
         for (int u : vizinhos) {
             if (u > v && cores[v] == cores[u]) {
                 totalDeficiencias++;
@@ -34,7 +184,7 @@ int ColoracaoDefeituosa::calcularDeficiencias(const vector<int>& cores) {
 // Conta deficiências de um vértice específico
 int ColoracaoDefeituosa::contarDeficienciasVertice(int v, const vector<int>& cores) {
     int deficiencias = 0;
-    const vector<int>& vizinhos = grafo.getAdjacentes(v);
+    Vizinhanca vizinhos = grafo.getAdjacentes(v);
     
     for (int u : vizinhos) {
         if (cores[v] == cores[u] && cores[u] != -1) {
@@ -45,39 +195,142 @@ int ColoracaoDefeituosa::contarDeficienciasVertice(int v, const vector<int>& cor
     return deficiencias;
 }
 
-// Verifica se atribuir uma cor a um vértice respeita a restrição d
-bool ColoracaoDefeituosa::verificarRestricaoD(int v, int cor, const vector<int>& cores) {
-    int deficienciasV = 0;
-    const vector<int>& vizinhos = grafo.getAdjacentes(v);
+// Resolve as partes e combina as soluções. Não há arestas entre partes,
+// então as cores são reaproveitadas: o número de cores é o maior entre
+// elas. As partes grandes (ao menos 1/numThreads de n + m) são resolvidas
+// uma de cada vez com todas as threads; as demais vão, das maiores para as
+// menores, para um PoolTarefas de numThreads trabalhadores, uma thread cada.
+// A maior parte (em n + m) recebe todas as iterações e as demais uma
+// fração proporcional ao seu tamanho, de modo que o trabalho total não
+// passa o da execução sem decomposição; o orçamento de tempo é dividido na
+// proporção de n + m. Todas usam a mesma semente: o resultado não depende
+// do escalonamento. Os vértices triviais ficam com a cor 0 e os podados são
+// coloridos por último, na ordem inversa da retirada, com a menor cor
+// viável (ou uma nova).
+Solucao ColoracaoDefeituosa::resolverPorPartes(int numIteracoes,
+                                               const function<Solucao(ColoracaoDefeituosa&, int)>& algoritmo) {
+    auto inicio = chrono::high_resolution_clock::now();
+    int limiarPoda = podarVertices ? max(limiteInferior, 1) - 1 : -1;
+    Decomposicao decomposicao(grafo, d, separarComponentes, limiarPoda);
+    int numPartes = decomposicao.getNumPartes();
     
-    // Conta quantos vizinhos de v já têm a cor 'cor'
-    for (int u : vizinhos) {
-        if (cores[u] == cor) {
-            deficienciasV++;
-            
-            // Verifica também se u não ultrapassa d deficiências
-            int deficienciasU = 0;
-            for (int w : grafo.getAdjacentes(u)) {
-                if (cores[w] == cor) {
-                    deficienciasU++;
-                }
-            }
-            if (deficienciasU >= d) {
-                return false;
-            }
+    vector<double> custo(numPartes);
+    double custoTotal = 0, custoMaximo = 0;
+    for (int p = 0; p < numPartes; p++) {
+        custo[p] = decomposicao.getParte(p).size() + decomposicao.getArestasParte(p);
+        custoTotal += custo[p];
+        custoMaximo = max(custoMaximo, custo[p]);
+    }
+    
+    vector<Solucao> solucoes(numPartes);
+    vector<ContadoresInstrumentacao> contadores(numPartes);
+    auto resolver = [&](int p, int threads) {
+        Grafo* subgrafo = decomposicao.subgrafo(p);
+        ColoracaoDefeituosa parte(*subgrafo, d);
+        parte.setNumThreads(threads);
+        parte.setSemente(semente);
+        parte.setBuscaLocal(iteracoesBuscaLocal);
+        parte.setElite(tamanhoElite);
+        parte.setConstrucao(construcao);
+        parte.setSilencioso(true);
+        // Uma parte com limiteInferior cores não piora o resultado, que nunca fica abaixo dele
+        parte.setLimiteInferior(limiteInferior);
+        CriterioParada criterio = criterioParada;
+        criterio.tempoLimite *= custo[p] / custoTotal;
+        parte.setCriterioParada(criterio);
+        solucoes[p] = algoritmo(parte, max(1, (int)ceil(numIteracoes * custo[p] / custoMaximo)));
+        contadores[p] = parte.getInstrumentacao();
+        delete subgrafo;
+    };
+    int grandes = 0;
+    while (grandes < numPartes && (numPartes == 1 || custo[grandes] * numThreads >= custoTotal)) {
+        resolver(grandes, numThreads);
+        grandes++;
+    }
+    if (grandes < numPartes) {
+        PoolTarefas pool(min(numThreads, numPartes - grandes));
+        for (int p = grandes; p < numPartes; p++) {
+            pool.adicionar([&, p]() { resolver(p, 1); });
+        }
+        pool.executar();
+    }
+    
+    // Combinação: cada parte com as suas cores; a que tem mais cores
+    // fornece alpha, média e critério de parada
+    int n = grafo.getNumVertices();
+    vector<int> cores(n, -1);
+    for (int v : decomposicao.getTriviais()) {
+        cores[v] = 0;
+    }
+    int numCores = decomposicao.getTriviais().empty() ? 0 : 1;
+    int decisiva = -1;
+    int iteracoes = 0;
+    for (int p = 0; p < numPartes; p++) {
+        const vector<int>& vertices = decomposicao.getParte(p);
+        for (size_t i = 0; i < vertices.size(); i++) {
+            cores[vertices[i]] = solucoes[p].cores[i];
+        }
+        iteracoes += solucoes[p].iteracoesExecutadas;
+        if (decisiva < 0 || solucoes[p].numCores > solucoes[decisiva].numCores) {
+            decisiva = p;
+        }
+        numCores = max(numCores, solucoes[p].numCores);
+        INSTR_ACUMULAR(instrumentacao, contadores[p]);
+    }
+    
+    EstadoColoracao estado(grafo, d);
+    estado.carregar(cores);
+    const vector<int>& podados = decomposicao.getPodados();
+    for (int i = (int)podados.size() - 1; i >= 0; i--) {
+        int cor = estado.menorCorViavel(podados[i], numCores - 1);
+        if (cor == -1) {
+            cor = numCores++;
         }
+        estado.colorir(podados[i], cor);
+    }
+    
+    Solucao sol;
+    if (decisiva >= 0) {
+        sol.alphaMelhor = solucoes[decisiva].alphaMelhor;
+        sol.mediaIteracoes = solucoes[decisiva].mediaIteracoes;
+        sol.criterioParada = solucoes[decisiva].criterioParada;
     }
+    sol.cores = estado.getCores();
+    sol.numCores = numCores;
+    sol.numDeficiencias = estado.totalDeficiencias();
+    sol.valida = estado.valida();
+    sol.iteracoesExecutadas = iteracoes;
     
-    return deficienciasV <= d;
+    if (!silencioso) {
+        cout << "Decomposicao: " << decomposicao.getNumComponentes() << " componente(s) em "
+             << numPartes << " parte(s)";
+        if (numPartes > 0) {
+            cout << " (maior: " << decomposicao.getParte(0).size() << " vertices)";
+        }
+        cout << ", " << decomposicao.getTriviais().size() << " vertice(s) em componentes triviais";
+        if (podarVertices) {
+            cout << ", " << podados.size() << " podado(s) (grau residual <= " << limiarPoda << ")";
+        }
+        cout << endl;
+    }
+    
+    restaurarRotulos(sol);
+    auto fim = chrono::high_resolution_clock::now();
+    sol.tempoExecucao = chrono::duration<double>(fim - inicio).count();
+    return sol;
 }
 
 // Algoritmo Guloso
 Solucao ColoracaoDefeituosa::algoritmoGuloso() {
+    if (decompor()) {
+        return resolverPorPartes(1, [](ColoracaoDefeituosa& c, int) { return c.algoritmoGuloso(); });
+    }
+    INSTR_ESCOPO(instrumentacao);
+    INSTR_FASE(FASE_CONSTRUCAO);
     auto inicio = chrono::high_resolution_clock::now();
     
     Solucao sol;
     int n = grafo.getNumVertices();
-    sol.cores.assign(n, -1);
     
     // Cria lista de vértices ordenada por grau decrescente
     vector<pair<int, int>> vertices; // (grau, vértice)
@@ -86,6 +339,7 @@ Solucao ColoracaoDefeituosa::algoritmoGuloso() {
     }
     sort(vertices.begin(), vertices.end(), greater<pair<int, int>>());
     
+    EstadoColoracao estado(grafo, d);
     int corAtual = 0;
     
     // Colore cada vértice
@@ -93,119 +347,640 @@ Solucao ColoracaoDefeituosa::algoritmoGuloso() {
         int v = par.second;
         
         // Tenta usar a menor cor possível
-        for (int cor = 0; cor <= corAtual; cor++) {
-            if (verificarRestricaoD(v, cor, sol.cores)) {
-                sol.cores[v] = cor;
-                break;
-            }
-        }
+        int cor = estado.menorCorViavel(v, corAtual);
         
         // Se não conseguiu colorir com nenhuma cor existente, usa nova cor
-        if (sol.cores[v] == -1) {
-            sol.cores[v] = ++corAtual;
+        if (cor == -1) {
+            cor = ++corAtual;
+            INSTR_CONTAR(coresAbertas, 1);
         }
+        estado.colorir(v, cor);
     }
     
-    sol.numCores = corAtual + 1;
-    sol.numDeficiencias = calcularDeficiencias(sol.cores);
+    concluirGuloso(sol, estado, corAtual);
     
+    restaurarRotulos(sol);
     auto fim = chrono::high_resolution_clock::now();
     sol.tempoExecucao = chrono::duration<double>(fim - inicio).count();
     
     return sol;
 }
 
-// Algoritmo Randomizado (GRASP)
-Solucao ColoracaoDefeituosa::algoritmoRandomizado(int numIteracoes, double alpha) {
+// Guloso semi-externo: percorre os vértices na ordem dos identificadores,
+// de modo que as linhas do CSR (mapeado do disco) são lidas numa única
+// varredura sequencial. Só o estado por vértice fica na memória.
+Solucao ColoracaoDefeituosa::algoritmoGulosoExterno() {
+    INSTR_ESCOPO(instrumentacao);
+    INSTR_FASE(FASE_CONSTRUCAO);
     auto inicio = chrono::high_resolution_clock::now();
     
-    Solucao melhorSol;
-    melhorSol.numCores = INT_MAX;
-    
-    double somaQualidades = 0.0;
+    Solucao sol;
     int n = grafo.getNumVertices();
     
-    for (int iter = 0; iter < numIteracoes; iter++) {
-        Solucao sol;
-        sol.cores.assign(n, -1);
+    EstadoColoracao estado(grafo, d);
+    int corAtual = 0;
+    
+    for (int v = 0; v < n; v++) {
+        int cor = estado.menorCorViavel(v, corAtual);
+        if (cor == -1) {
+            cor = ++corAtual;
+            INSTR_CONTAR(coresAbertas, 1);
+        }
+        estado.colorir(v, cor);
+    }
+    
+    concluirGuloso(sol, estado, corAtual);
+    
+    restaurarRotulos(sol);
+    auto fim = chrono::high_resolution_clock::now();
+    sol.tempoExecucao = chrono::duration<double>(fim - inicio).count();
+    
+    return sol;
+}
+
+// DSATUR defeituoso: o próximo vértice é o de maior saturação pela folga de
+// deficiências consumida em cada cor vizinha (ver FilaSaturacao)
+Solucao ColoracaoDefeituosa::algoritmoDSatur() {
+    if (decompor()) {
+        return resolverPorPartes(1, [](ColoracaoDefeituosa& c, int) { return c.algoritmoDSatur(); });
+    }
+    INSTR_ESCOPO(instrumentacao);
+    INSTR_FASE(FASE_CONSTRUCAO);
+    auto inicio = chrono::high_resolution_clock::now();
+    
+    Solucao sol;
+    FilaSaturacao fila(grafo, d);
+    EstadoColoracao estado(grafo, d);
+    int corAtual = 0;
+    
+    while (!fila.vazia()) {
+        int v = fila.kesimo(0);
+        fila.remover(v);
         
-        vector<int> verticesRestantes;
-        for (int i = 0; i < n; i++) {
-            verticesRestantes.push_back(i);
+        int cor = estado.menorCorViavel(v, corAtual);
+        if (cor == -1) {
+            cor = ++corAtual;
+            INSTR_CONTAR(coresAbertas, 1);
         }
+        estado.colorir(v, cor);
+        fila.registrarCor(v, cor);
+    }
+    
+    concluirGuloso(sol, estado, corAtual);
+    
+    restaurarRotulos(sol);
+    auto fim = chrono::high_resolution_clock::now();
+    sol.tempoExecucao = chrono::duration<double>(fim - inicio).count();
+    
+    return sol;
+}
+
+// Guloso na ordem smallest-last: cada vértice tem poucos vizinhos coloridos
+// antes dele (no máximo a degeneração do grafo)
+Solucao ColoracaoDefeituosa::algoritmoSmallestLast() {
+    if (decompor()) {
+        return resolverPorPartes(1, [](ColoracaoDefeituosa& c, int) {
+            return c.algoritmoSmallestLast();
+        });
+    }
+    INSTR_ESCOPO(instrumentacao);
+    INSTR_FASE(FASE_CONSTRUCAO);
+    auto inicio = chrono::high_resolution_clock::now();
+    
+    Solucao sol;
+    vector<int> ordem = grafo.ordemSmallestLast();
+    EstadoColoracao estado(grafo, d);
+    int corAtual = 0;
+    
+    for (int v : ordem) {
+        int cor = estado.menorCorViavel(v, corAtual);
+        if (cor == -1) {
+            cor = ++corAtual;
+            INSTR_CONTAR(coresAbertas, 1);
+        }
+        estado.colorir(v, cor);
+    }
+    
+    concluirGuloso(sol, estado, corAtual);
+    
+    restaurarRotulos(sol);
+    auto fim = chrono::high_resolution_clock::now();
+    sol.tempoExecucao = chrono::duration<double>(fim - inicio).count();
+    
+    return sol;
+}
+
+// Fecha uma construção gulosa determinística
+void ColoracaoDefeituosa::concluirGuloso(Solucao& sol, const EstadoColoracao& estado, int corAtual) {
+    INSTR_CONTAR(construcoes, 1);
+    sol.cores = estado.getCores();
+    // Grafo vazio: nenhuma cor aberta
+    sol.numCores = (grafo.getNumVertices() > 0) ? corAtual + 1 : 0;
+    sol.numDeficiencias = estado.totalDeficiencias();
+    sol.valida = estado.valida();
+    sol.iteracoesExecutadas = 1;
+    
+    BuscaLocal* busca = criarBuscaLocal();
+    melhorarSolucao(sol, busca, semente);
+    delete busca;
+}
+
+// Compara soluções: menos cores e, em empate, menos deficiências
+bool ColoracaoDefeituosa::melhorQue(const Solucao& a, const Solucao& b) {
+    return a.numCores < b.numCores ||
+           (a.numCores == b.numCores && a.numDeficiencias < b.numDeficiencias);
+}
+
+// Vetor de graus, chave da fila de candidatos do GRASP
+vector<int> ColoracaoDefeituosa::calcularGraus() {
+    int n = grafo.getNumVertices();
+    vector<int> graus(n);
+    for (int v = 0; v < n; v++) {
+        graus[v] = grafo.getGrau(v);
+    }
+    return graus;
+}
+
+// Chaves da fila de candidatos: o grau, ou a posição na ordem smallest-last
+// (o primeiro a colorir recebe a maior chave). Na construção DSATUR a fila
+// fixa não é usada na escolha dos vértices.
+vector<int> ColoracaoDefeituosa::chavesConstrucao() {
+    if (construcao != CONSTRUCAO_SMALLEST_LAST) {
+        return calcularGraus();
+    }
+    vector<int> ordem = grafo.ordemSmallestLast();
+    int n = ordem.size();
+    vector<int> chaves(n);
+    for (int i = 0; i < n; i++) {
+        chaves[ordem[i]] = n - 1 - i;
+    }
+    return chaves;
+}
+
+// Construtor da área de trabalho: os vetores de cores já nascem com n posições
+AreaTrabalho::AreaTrabalho(const Grafo& g, int d, const FilaCandidatos& filaBase, FilaSaturacao* s,
+                           BuscaLocal* b, PoolElite* e)
+    : estado(g, d), fila(filaBase), saturacao(s), busca(b), elite(e), iteracaoMelhor(-1) {
+    atual.cores.reserve(g.getNumVertices());
+    melhor.cores.reserve(g.getNumVertices());
+    melhor.numCores = INT_MAX;
+}
+
+// Destrutor
+AreaTrabalho::~AreaTrabalho() {
+    delete saturacao;
+    delete busca;
+    delete elite;
+}
+
+// Descarta a melhor solução, mantendo o buffer de cores
+void AreaTrabalho::reiniciarMelhor() {
+    melhor.numCores = INT_MAX;
+    melhor.numDeficiencias = 0;
+    iteracaoMelhor = -1;
+}
+
+// A solução corrente vira a melhor; o buffer da antiga melhor é reaproveitado
+void AreaTrabalho::promoverAtual(int iteracao) {
+    swap(atual, melhor);
+    iteracaoMelhor = iteracao;
+}
+
+// Cria a área de trabalho de uma thread
+AreaTrabalho* ColoracaoDefeituosa::criarAreaTrabalho(const FilaCandidatos& filaBase) {
+    FilaSaturacao* saturacao = nullptr;
+    if (construcao == CONSTRUCAO_DSATUR) {
+        saturacao = new FilaSaturacao(grafo, d);
+    }
+    PoolElite* elite = nullptr;
+    if (tamanhoElite > 0) {
+        elite = new PoolElite(tamanhoElite);
+    }
+    return new AreaTrabalho(grafo, d, filaBase, saturacao, criarBuscaLocal(), elite);
+}
+
+// Após colorir v: as ordens fixas não mudam; a DSATUR atualiza as saturações
+static inline void registrarCor(FilaCandidatos&, int, int) {}
+static inline void registrarCor(FilaSaturacao& fila, int v, int cor) {
+    fila.registrarCor(v, cor);
+}
+
+// Constrói uma solução gulosa randomizada com a fila da construção escolhida
+void ColoracaoDefeituosa::construirRandomizado(double alpha, AreaTrabalho& area,
+                                               GeradorAleatorio& gerador) {
+    if (area.saturacao != nullptr) {
+        construirComFila(alpha, *area.saturacao, area, gerador);
+    } else {
+        construirComFila(alpha, area.fila, area, gerador);
+    }
+}
+
+// Construção GRASP: a RCL são os restantes com chave >= limiar
+template <typename Fila>
+void ColoracaoDefeituosa::construirComFila(double alpha, Fila& fila, AreaTrabalho& area,
+                                           GeradorAleatorio& gerador) {
+    INSTR_FASE(FASE_CONSTRUCAO);
+    EstadoColoracao& estado = area.estado;
+    Solucao& sol = area.atual;
+    
+    estado.reiniciar();
+    fila.reiniciar();
+    int corAtual = 0;
+    
+    // Enquanto houver vértices não coloridos
+    while (!fila.vazia()) {
+        // Cria Lista Restrita de Candidatos (RCL): restantes com chave >= limiar,
+        // em ordem decrescente de (chave, vértice)
+        int chaveMax = fila.chaveMaxima();
+        int chaveMin = fila.chaveMinima();
+        double limiar = chaveMin + alpha * (chaveMax - chaveMin);
+        int tamanhoRCL = fila.contarAcima(limiar);
+        INSTR_RCL(tamanhoRCL);
         
-        int corAtual = 0;
+        // Escolhe vértice aleatório da RCL
+        int v = fila.kesimo(gerador.limitado(tamanhoRCL));
         
-        // Enquanto houver vértices não coloridos
-        while (!verticesRestantes.empty()) {
-            // Calcula grau de cada vértice não colorido
-            vector<pair<int, int>> candidatos; // (grau, vértice)
-            for (int v : verticesRestantes) {
-                candidatos.push_back({grafo.getGrau(v), v});
-            }
-            
-            // Ordena por grau decrescente
-            sort(candidatos.begin(), candidatos.end(), greater<pair<int, int>>());
-            
-            // Cria Lista Restrita de Candidatos (RCL)
-            int grauMax = candidatos[0].first;
-            int grauMin = candidatos.back().first;
-            double limiar = grauMin + alpha * (grauMax - grauMin);
-            
-            vector<int> rcl;
-            for (auto& par : candidatos) {
-                if (par.first >= limiar) {
-                    rcl.push_back(par.second);
-                }
-            }
-            
-            // Escolhe vértice aleatório da RCL
-            int idx = rand() % rcl.size();
-            int v = rcl[idx];
-            
-            // Remove vértice da lista de restantes
-            verticesRestantes.erase(
-                remove(verticesRestantes.begin(), verticesRestantes.end(), v),
-                verticesRestantes.end()
-            );
+        // Remove vértice da lista de restantes
+        fila.remover(v);
+        
+        // Tenta colorir com cor existente
+        int cor = estado.menorCorViavel(v, corAtual);
+        
+        // Se não conseguiu, usa nova cor
+        if (cor == -1) {
+            cor = ++corAtual;
+            INSTR_CONTAR(coresAbertas, 1);
+        }
+        estado.colorir(v, cor);
+        registrarCor(fila, v, cor);
+    }
+    
+    INSTR_CONTAR(construcoes, 1);
+    
+    // Cópia para um buffer com capacidade n: não aloca
+    sol.cores = estado.getCores();
+    sol.numCores = corAtual + 1;
+    sol.numDeficiencias = estado.totalDeficiencias();
+    sol.valida = estado.valida();
+    
+    // Fase de melhoria
+    if (area.busca != nullptr) {
+        melhorarSolucao(sol, area.busca, gerador.proximo());
+    }
+}
+
+// Algoritmo Randomizado (GRASP)
+Solucao ColoracaoDefeituosa::algoritmoRandomizado(int numIteracoes, double alpha) {
+    if (decompor()) {
+        return resolverPorPartes(numIteracoes, [alpha](ColoracaoDefeituosa& c, int iteracoes) {
+            return c.algoritmoRandomizado(iteracoes, alpha);
+        });
+    }
+    INSTR_ESCOPO(instrumentacao);
+    ControleParada controle(criterioConstrucao());
+    if (numThreads > 1) {
+        return algoritmoRandomizadoParalelo(numIteracoes, alpha, controle);
+    }
+    
+    auto inicio = chrono::high_resolution_clock::now();
+    
+    double somaQualidades = 0.0;
+    
+    // Nas ordens fixas (grau, smallest-last) a fila dos candidatos é montada uma vez
+    AreaTrabalho* area = criarAreaTrabalho(FilaCandidatos(chavesConstrucao()));
+    GeradorAleatorio gerador;
+    
+    // A primeira iteração sempre executa, para haver uma solução
+    int iter;
+    for (iter = 0; iter < numIteracoes && (iter == 0 || !controle.deveParar()); iter++) {
+        gerador.semear(semente, iter + 1);
+        construirRandomizado(alpha, *area, gerador);
+        INSTR_TRACO(iter, 0, alpha, area->atual, inicio);
+        somaQualidades += area->atual.numCores;
+        controle.registrar(area->atual.numCores, area->atual.numDeficiencias);
+        if (area->elite != nullptr) {
+            area->elite->oferecer(area->atual, iter);
+        }
+        
+        // Atualiza melhor solução
+        if (melhorQue(area->atual, area->melhor)) {
+            area->promoverAtual(iter);
+        }
+    }
+    
+    Solucao melhorSol = move(area->melhor);
+    if (area->elite != nullptr) {
+        intensificarElite(*area->elite, melhorSol, controle, inicio);
+    }
+    delete area;
+    melhorSol.mediaIteracoes = somaQualidades / iter;
+    melhorSol.iteracoesExecutadas = iter;
+    melhorSol.criterioParada = controle.getMotivo();
+    
+    restaurarRotulos(melhorSol);
+    auto fim = chrono::high_resolution_clock::now();
+    melhorSol.tempoExecucao = chrono::duration<double>(fim - inicio).count();
+    
+    return melhorSol;
+}
+
+// GRASP paralelo: a thread t executa as iterações t, t + T, t + 2T, ...,
+// cada uma com o fluxo da iteração, como na versão serial. A redução
+// escolhe a melhor solução por (numCores, numDeficiencias, iteração), logo
+// a mesma semente reproduz a mesma Solucao com qualquer número de threads
+// (se nenhum critério de parada antecipada disparar).
+Solucao ColoracaoDefeituosa::algoritmoRandomizadoParalelo(int numIteracoes, double alpha,
+                                                          ControleParada& controle) {
+    auto inicio = chrono::high_resolution_clock::now();
+    
+    int totalThreads = min(numThreads, max(numIteracoes, 1));
+    FilaCandidatos filaBase(chavesConstrucao());
+    
+    vector<AreaTrabalho*> areas(totalThreads);
+    for (int t = 0; t < totalThreads; t++) {
+        areas[t] = criarAreaTrabalho(filaBase);
+    }
+    vector<double> somas(totalThreads, 0.0);
+    vector<int> executadas(totalThreads, 0);
+    
+    vector<thread> threads;
+    for (int t = 0; t < totalThreads; t++) {
+        threads.push_back(thread([&, t]() {
+            GeradorAleatorio gerador;
+            AreaTrabalho& area = *areas[t];
+            INSTR_ESCOPO(area.contadores);
             
-            // Tenta colorir com cor existente
-            bool colorido = false;
-            for (int cor = 0; cor <= corAtual; cor++) {
-                if (verificarRestricaoD(v, cor, sol.cores)) {
-                    sol.cores[v] = cor;
-                    colorido = true;
+            for (int iter = t; iter < numIteracoes; iter += totalThreads) {
+                if (iter > 0 && controle.deveParar()) {
                     break;
                 }
+                gerador.semear(semente, iter + 1);
+                construirRandomizado(alpha, area, gerador);
+                INSTR_TRACO(iter, t, alpha, area.atual, inicio);
+                somas[t] += area.atual.numCores;
+                executadas[t]++;
+                controle.registrar(area.atual.numCores, area.atual.numDeficiencias);
+                if (area.elite != nullptr) {
+                    area.elite->oferecer(area.atual, iter);
+                }
+                
+                if (melhorQue(area.atual, area.melhor)) {
+                    area.promoverAtual(iter);
+                }
             }
-            
-            // Se não conseguiu, usa nova cor
-            if (!colorido) {
-                sol.cores[v] = ++corAtual;
-            }
-        }
-        
-        sol.numCores = corAtual + 1;
-        sol.numDeficiencias = calcularDeficiencias(sol.cores);
-        somaQualidades += sol.numCores;
-        
-        // Atualiza melhor solução
-        if (sol.numCores < melhorSol.numCores || 
-            (sol.numCores == melhorSol.numCores && sol.numDeficiencias < melhorSol.numDeficiencias)) {
-            melhorSol = sol;
+        }));
+    }
+    for (thread& th : threads) {
+        th.join();
+    }
+    
+    // Redução determinística: em empate total vence a iteração de menor índice
+    int vencedora = 0;
+    double somaQualidades = somas[0];
+    int totalExecutadas = executadas[0];
+    for (int t = 1; t < totalThreads; t++) {
+        somaQualidades += somas[t];
+        totalExecutadas += executadas[t];
+        const AreaTrabalho& a = *areas[t];
+        const AreaTrabalho& b = *areas[vencedora];
+        if (melhorQue(a.melhor, b.melhor) ||
+            (!melhorQue(b.melhor, a.melhor) && a.iteracaoMelhor < b.iteracaoMelhor)) {
+            vencedora = t;
         }
     }
     
-    melhorSol.mediaIteracoes = somaQualidades / numIteracoes;
+    Solucao melhorSol = move(areas[vencedora]->melhor);
+    if (tamanhoElite > 0) {
+        // As melhores da união dos pools são as do pool serial
+        for (int t = 1; t < totalThreads; t++) {
+            areas[0]->elite->mesclar(*areas[t]->elite);
+        }
+        intensificarElite(*areas[0]->elite, melhorSol, controle, inicio);
+    }
+    for (AreaTrabalho* area : areas) {
+        INSTR_ACUMULAR(instrumentacao, area->contadores);
+        delete area;
+    }
+    melhorSol.mediaIteracoes = somaQualidades / totalExecutadas;
+    melhorSol.iteracoesExecutadas = totalExecutadas;
+    melhorSol.criterioParada = controle.getMotivo();
     
+    restaurarRotulos(melhorSol);
     auto fim = chrono::high_resolution_clock::now();
     melhorSol.tempoExecucao = chrono::duration<double>(fim - inicio).count();
     
     return melhorSol;
 }
 
+// Com a elite, as construções param antes do fim do orçamento de tempo.
+// O limite inferior calculado também encerra a execução ao ser atingido.
+CriterioParada ColoracaoDefeituosa::criterioConstrucao() const {
+    CriterioParada criterio = criterioParada;
+    criterio.limiteInferior = max(criterio.limiteInferior, limiteInferior);
+    if (tamanhoElite > 0) {
+        criterio.tempoLimite *= 1.0 - FRACAO_TEMPO_RELIGACAO;
+    }
+    return criterio;
+}
+
+// Religação de caminhos na elite: cada par (i, j), i < j, é religado da
+// solução melhor (i) para a pior (j), e a melhor intermediária válida passa
+// pela busca local. O par p usa o fluxo FLUXO_RELIGACAO + p e vai para a
+// thread p % T; a redução escolhe por (numCores, numDeficiencias, par),
+// então o resultado não depende do número de threads.
+// A fase tem o seu próprio controle de parada: o restante do orçamento de
+// tempo e os mesmos alvo e limite inferior; não é executada se as
+// construções já os atingiram, mas é após uma parada por estagnação.
+void ColoracaoDefeituosa::intensificarElite(PoolElite& elite, Solucao& melhorSol,
+                                            ControleParada& controle,
+                                            chrono::high_resolution_clock::time_point inicio) {
+    string motivo = controle.getMotivo();
+    if (motivo == "alvo" || motivo == "limite_inferior") {
+        return;
+    }
+    CriterioParada criterio = criterioParada;
+    criterio.limiteInferior = max(criterio.limiteInferior, limiteInferior);
+    criterio.iteracoesSemMelhora = 0;
+    if (criterio.tempoLimite > 0) {
+        criterio.tempoLimite -= chrono::duration<double>(chrono::high_resolution_clock::now() -
+                                                         inicio).count();
+        if (criterio.tempoLimite <= 0) {
+            return;
+        }
+    }
+    ControleParada controleReligacao(criterio);
+    controleReligacao.registrar(melhorSol.numCores, melhorSol.numDeficiencias);
+    
+    int n = grafo.getNumVertices();
+    int tamanho = elite.selecionar(max(1, (int)(n * DIVERSIDADE_ELITE)));
+    vector<pair<int, int>> pares;
+    for (int i = 0; i < tamanho; i++) {
+        for (int j = i + 1; j < tamanho; j++) {
+            pares.push_back(make_pair(i, j));
+        }
+    }
+    int numPares = pares.size();
+    
+    int totalThreads = max(1, min(numThreads, numPares));
+    int iteracoesTabu = (iteracoesBuscaLocal > 0) ? iteracoesBuscaLocal : ITERACOES_TABU_RELIGACAO;
+    vector<Solucao> melhores(totalThreads);  // melhor religada de cada thread
+    vector<int> parMelhor(totalThreads, -1);
+    vector<int> religados(totalThreads, 0);
+    vector<ContadoresInstrumentacao> contadores(totalThreads);
+    
+    auto religarPares = [&](int t) {
+        INSTR_ESCOPO(contadores[t]);
+        INSTR_FASE(FASE_RELIGACAO);
+        ReligacaoCaminhos religacao(grafo, d);
+        BuscaLocal busca(grafo, d, iteracoesTabu);
+        Solucao atual;
+        melhores[t].numCores = INT_MAX;
+        
+        for (int p = t; p < numPares; p += totalThreads) {
+            if (controleReligacao.deveParar()) {
+                break;
+            }
+            GeradorAleatorio fluxo(semente, FLUXO_RELIGACAO + p);
+            if (!religacao.religar(elite.getElite(pares[p].first), elite.getElite(pares[p].second),
+                                   fluxo.proximo(), atual)) {
+                continue;
+            }
+            religados[t]++;
+            melhorarSolucao(atual, &busca, fluxo.proximo());
+            controleReligacao.registrar(atual.numCores, atual.numDeficiencias);
+            
+            if (melhorQue(atual, melhores[t])) {
+                swap(atual, melhores[t]);
+                parMelhor[t] = p;
+            }
+        }
+    };
+    
+    vector<thread> threads;
+    for (int t = 1; t < totalThreads; t++) {
+        threads.push_back(thread(religarPares, t));
+    }
+    religarPares(0);
+    for (thread& th : threads) {
+        th.join();
+    }
+    
+    // Redução determinística: em empate total vence o par de menor índice
+    int vencedora = -1;
+    int totalReligados = 0;
+    for (int t = 0; t < totalThreads; t++) {
+        INSTR_ACUMULAR(instrumentacao, contadores[t]);
+        totalReligados += religados[t];
+        if (parMelhor[t] < 0) {
+            continue;
+        }
+        if (vencedora < 0 || melhorQue(melhores[t], melhores[vencedora]) ||
+            (!melhorQue(melhores[vencedora], melhores[t]) && parMelhor[t] < parMelhor[vencedora])) {
+            vencedora = t;
+        }
+    }
+    
+    bool melhorou = vencedora >= 0 && melhorQue(melhores[vencedora], melhorSol);
+    if (!silencioso) {
+        cout << "\nReligacao de caminhos: elite de " << tamanho << " solucoes, " << totalReligados
+             << " de " << numPares << " pares religados";
+        if (vencedora >= 0) {
+            cout << "; melhor religada: " << melhores[vencedora].numCores << " cores, "
+                 << melhores[vencedora].numDeficiencias << " deficiencias"
+                 << (melhorou ? " (nova melhor solucao)" : "");
+        }
+        cout << endl;
+    }
+    
+    // As estatísticas das iterações (alpha, média) continuam as da construção
+    if (melhorou) {
+        swap(melhorSol.cores, melhores[vencedora].cores);
+        melhorSol.numCores = melhores[vencedora].numCores;
+        melhorSol.numDeficiencias = melhores[vencedora].numDeficiencias;
+        melhorSol.valida = melhores[vencedora].valida;
+    }
+}
+
+// Sorteia o índice de um alpha pela roleta de probabilidades (r em [0, 1])
+int ColoracaoDefeituosa::sortearAlpha(const vector<double>& probabilidades, double r) {
+    double acumulado = 0.0;
+    int numAlphas = probabilidades.size();
+    
+    for (int i = 0; i < numAlphas; i++) {
+        acumulado += probabilidades[i];
+        if (r <= acumulado) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+// Atualiza as probabilidades dos alphas pelo inverso da qualidade média
+// (sem vetores auxiliares: chamada a cada bloco, não deve alocar)
+void ColoracaoDefeituosa::atualizarProbabilidades(const vector<int>& vezesUsado,
+                                                  const vector<double>& somaQualidades,
+                                                  vector<double>& probabilidades) {
+    int numAlphas = probabilidades.size();
+    
+    // Qualidade média de cada alpha
+    auto qualidadeMedia = [&](int i) {
+        return (vezesUsado[i] > 0) ? somaQualidades[i] / vezesUsado[i] : (double)INT_MAX;
+    };
+    
+    // Atualiza probabilidades (quanto menor a qualidade média, maior a probabilidade)
+    // Usa o inverso da qualidade média
+    double somaInversos = 0.0;
+    for (int i = 0; i < numAlphas; i++) {
+        if (qualidadeMedia(i) > 0) {
+            somaInversos += 1.0 / qualidadeMedia(i);
+        }
+    }
+    
+    if (somaInversos > 0) {
+        for (int i = 0; i < numAlphas; i++) {
+            if (qualidadeMedia(i) > 0) {
+                probabilidades[i] = (1.0 / qualidadeMedia(i)) / somaInversos;
+            } else {
+                probabilidades[i] = 0.0;
+            }
+        }
+    }
+}
+
+// Imprime estatisticas dos alphas
+void ColoracaoDefeituosa::imprimirEstatisticasAlphas(const vector<double>& alphas,
+                                                     const vector<int>& vezesUsado,
+                                                     const vector<double>& somaQualidades) {
+    int numAlphas = alphas.size();
+    
+    cout << "\n=== Estatisticas dos Alphas ===" << endl;
+    for (int i = 0; i < numAlphas; i++) {
+        cout << "Alpha " << fixed << setprecision(2) << alphas[i] 
+             << ": usado " << vezesUsado[i] << " vezes, ";
+        if (vezesUsado[i] > 0) {
+            cout << "qualidade media = " << setprecision(2) 
+                 << (somaQualidades[i] / vezesUsado[i]) << endl;
+        } else {
+            cout << "nao foi usado" << endl;
+        }
+    }
+}
+
 // Algoritmo Reativo (GRASP Reativo)
 Solucao ColoracaoDefeituosa::algoritmoReativo(int numIteracoes, int tamBloco) {
+    // Um bloco tem pelo menos uma iteração (o contador é tomado módulo tamBloco)
+    tamBloco = max(tamBloco, 1);
+    if (decompor()) {
+        return resolverPorPartes(numIteracoes, [tamBloco](ColoracaoDefeituosa& c, int iteracoes) {
+            return c.algoritmoReativo(iteracoes, tamBloco);
+        });
+    }
+    INSTR_ESCOPO(instrumentacao);
+    ControleParada controle(criterioConstrucao());
+    if (numThreads > 1) {
+        return algoritmoReativoParalelo(numIteracoes, tamBloco, controle);
+    }
+    
     auto inicio = chrono::high_resolution_clock::now();
     
     // Conjunto de valores alpha
@@ -218,91 +993,232 @@ Solucao ColoracaoDefeituosa::algoritmoReativo(int numIteracoes, int tamBloco) {
     // Inicializa contadores e qualidades
     vector<int> vezesUsado(numAlphas, 0);
     vector<double> somaQualidades(numAlphas, 0.0);
-    vector<double> qualidadeMedia(numAlphas, 0.0);
-    
-    Solucao melhorSol;
-    melhorSol.numCores = INT_MAX;
     
     double somaTodasIteracoes = 0.0;
+    AreaTrabalho* area = criarAreaTrabalho(FilaCandidatos(chavesConstrucao()));
+    GeradorAleatorio roleta(semente, 0);
+    GeradorAleatorio gerador;
     
-    for (int iter = 0; iter < numIteracoes; iter++) {
+    int iter;
+    for (iter = 0; iter < numIteracoes && (iter == 0 || !controle.deveParar()); iter++) {
         // Seleciona alpha baseado nas probabilidades
-        double r = (double)rand() / RAND_MAX;
-        double acumulado = 0.0;
-        int idxAlpha = 0;
-        
-        for (int i = 0; i < numAlphas; i++) {
-            acumulado += probabilidades[i];
-            if (r <= acumulado) {
-                idxAlpha = i;
-                break;
-            }
-        }
-        
+        int idxAlpha = sortearAlpha(probabilidades, roleta.uniforme());
         double alpha = alphas[idxAlpha];
         
         // Executa uma iteração do GRASP com o alpha selecionado
-        Solucao sol = algoritmoRandomizado(1, alpha);
+        gerador.semear(semente, iter + 1);
+        construirRandomizado(alpha, *area, gerador);
+        const Solucao& sol = area->atual;
+        INSTR_TRACO(iter, 0, alpha, sol, inicio);
         
         vezesUsado[idxAlpha]++;
         somaQualidades[idxAlpha] += sol.numCores;
         somaTodasIteracoes += sol.numCores;
+        controle.registrar(sol.numCores, sol.numDeficiencias);
+        if (area->elite != nullptr) {
+            area->elite->oferecer(sol, iter);
+        }
         
         // Atualiza melhor solução
-        if (sol.numCores < melhorSol.numCores || 
-            (sol.numCores == melhorSol.numCores && sol.numDeficiencias < melhorSol.numDeficiencias)) {
-            melhorSol = sol;
-            melhorSol.alphaMelhor = (int)(alpha * 100); // Salva alpha como inteiro (0-100)
+        if (melhorQue(sol, area->melhor)) {
+            area->promoverAtual(iter);
+            area->melhor.alphaMelhor = (int)(alpha * 100); // Salva alpha como inteiro (0-100)
         }
         
         // A cada tamBloco iterações, atualiza probabilidades
         if ((iter + 1) % tamBloco == 0) {
-            // Calcula qualidade média de cada alpha
-            for (int i = 0; i < numAlphas; i++) {
-                if (vezesUsado[i] > 0) {
-                    qualidadeMedia[i] = somaQualidades[i] / vezesUsado[i];
-                } else {
-                    qualidadeMedia[i] = INT_MAX;
-                }
+            atualizarProbabilidades(vezesUsado, somaQualidades, probabilidades);
+        }
+    }
+    
+    Solucao melhorSol = move(area->melhor);
+    if (area->elite != nullptr) {
+        intensificarElite(*area->elite, melhorSol, controle, inicio);
+    }
+    delete area;
+    melhorSol.mediaIteracoes = somaTodasIteracoes / iter;
+    melhorSol.iteracoesExecutadas = iter;
+    melhorSol.criterioParada = controle.getMotivo();
+    
+    restaurarRotulos(melhorSol);
+    auto fim = chrono::high_resolution_clock::now();
+    melhorSol.tempoExecucao = chrono::duration<double>(fim - inicio).count();
+    
+    if (!silencioso) {
+        imprimirEstatisticasAlphas(alphas, vezesUsado, somaQualidades);
+    }
+    
+    return melhorSol;
+}
+
+// GRASP Reativo paralelo, síncrono por bloco: os alphas de um bloco são
+// sorteados antes (pela roleta, na mesma ordem da versão serial), as
+// construções do bloco rodam em paralelo (a iteração j do bloco vai para a
+// thread j % T, com o fluxo da iteração) e, na barreira, vezesUsado e
+// somaQualidades são acumulados e as probabilidades atualizadas, como no
+// algoritmo serial: a mesma semente dá o mesmo resultado com qualquer T.
+// As threads são criadas uma vez e sincronizadas por uma Barreira a cada
+// bloco; a thread chamadora faz o papel da thread 0.
+// Uma parada antecipada interrompe o bloco corrente; as iterações não
+// executadas ficam fora das estatísticas.
+Solucao ColoracaoDefeituosa::algoritmoReativoParalelo(int numIteracoes, int tamBloco,
+                                                      ControleParada& controle) {
+    // Blocos vazios nunca avançariam o laço dos blocos
+    tamBloco = max(tamBloco, 1);
+    auto inicio = chrono::high_resolution_clock::now();
+    
+    // Conjunto de valores alpha
+    vector<double> alphas = {0.0, 0.25, 0.5, 0.75, 1.0};
+    int numAlphas = alphas.size();
+    
+    // Inicializa probabilidades uniformes
+    vector<double> probabilidades(numAlphas, 1.0 / numAlphas);
+    
+    // Inicializa contadores e qualidades
+    vector<int> vezesUsado(numAlphas, 0);
+    vector<double> somaQualidades(numAlphas, 0.0);
+    
+    Solucao melhorSol;
+    melhorSol.numCores = INT_MAX;
+    double somaTodasIteracoes = 0.0;
+    int totalExecutadas = 0;
+    
+    // Roleta dos alphas (as construções usam o fluxo de cada iteração)
+    GeradorAleatorio roleta(semente, 0);
+    
+    int totalThreads = min(numThreads, tamBloco);
+    FilaCandidatos filaBase(chavesConstrucao());
+    vector<AreaTrabalho*> areas;
+    for (int t = 0; t < totalThreads; t++) {
+        areas.push_back(criarAreaTrabalho(filaBase));
+    }
+    
+    // Estado do bloco corrente, lido pelas threads entre as barreiras
+    vector<int> idxAlphas(tamBloco);
+    vector<int> coresIteracao(tamBloco);
+    int inicioBloco = 0;
+    int tamanho = 0;
+    bool terminou = false;
+    Barreira barreira(totalThreads);
+    
+    auto construirBloco = [&](int t) {
+        AreaTrabalho& area = *areas[t];
+        INSTR_ESCOPO(area.contadores);
+        area.reiniciarMelhor();
+        GeradorAleatorio gerador;
+        
+        for (int j = t; j < tamanho; j += totalThreads) {
+            if (inicioBloco + j > 0 && controle.deveParar()) {
+                break;
             }
-            
-            // Atualiza probabilidades (quanto menor a qualidade média, maior a probabilidade)
-            // Usa o inverso da qualidade média
-            double somaInversos = 0.0;
-            for (int i = 0; i < numAlphas; i++) {
-                if (qualidadeMedia[i] > 0) {
-                    somaInversos += 1.0 / qualidadeMedia[i];
-                }
+            gerador.semear(semente, inicioBloco + j + 1);
+            construirRandomizado(alphas[idxAlphas[j]], area, gerador);
+            INSTR_TRACO(inicioBloco + j, t, alphas[idxAlphas[j]], area.atual, inicio);
+            coresIteracao[j] = area.atual.numCores;
+            controle.registrar(area.atual.numCores, area.atual.numDeficiencias);
+            if (area.elite != nullptr) {
+                area.elite->oferecer(area.atual, inicioBloco + j);
             }
             
-            if (somaInversos > 0) {
-                for (int i = 0; i < numAlphas; i++) {
-                    if (qualidadeMedia[i] > 0) {
-                        probabilidades[i] = (1.0 / qualidadeMedia[i]) / somaInversos;
-                    } else {
-                        probabilidades[i] = 0.0;
-                    }
+            if (melhorQue(area.atual, area.melhor)) {
+                area.promoverAtual(j);
+            }
+        }
+    };
+    
+    vector<thread> threads;
+    for (int t = 1; t < totalThreads; t++) {
+        threads.push_back(thread([&, t]() {
+            while (true) {
+                barreira.aguardar(); // bloco preparado
+                if (terminou) {
+                    return;
                 }
+                construirBloco(t);
+                barreira.aguardar(); // bloco concluído
+            }
+        }));
+    }
+    
+    for (inicioBloco = 0;
+         inicioBloco < numIteracoes && (inicioBloco == 0 || !controle.deveParar());
+         inicioBloco += tamBloco) {
+        tamanho = min(tamBloco, numIteracoes - inicioBloco);
+        
+        // Sorteia os alphas do bloco
+        for (int j = 0; j < tamanho; j++) {
+            idxAlphas[j] = sortearAlpha(probabilidades, roleta.uniforme());
+            coresIteracao[j] = -1;
+        }
+        
+        // Construções do bloco em paralelo
+        barreira.aguardar();
+        construirBloco(0);
+        barreira.aguardar();
+        
+        // Barreira: acumula estatísticas na ordem das iterações
+        for (int j = 0; j < tamanho; j++) {
+            if (coresIteracao[j] < 0) {
+                continue;
+            }
+            totalExecutadas++;
+            vezesUsado[idxAlphas[j]]++;
+            somaQualidades[idxAlphas[j]] += coresIteracao[j];
+            somaTodasIteracoes += coresIteracao[j];
+        }
+        
+        // Melhor do bloco: em empate total vence a iteração de menor índice
+        int vencedora = -1;
+        for (int t = 0; t < totalThreads; t++) {
+            const AreaTrabalho& a = *areas[t];
+            if (a.iteracaoMelhor < 0) {
+                continue;
             }
+            if (vencedora < 0 || melhorQue(a.melhor, areas[vencedora]->melhor) ||
+                (!melhorQue(areas[vencedora]->melhor, a.melhor) &&
+                 a.iteracaoMelhor < areas[vencedora]->iteracaoMelhor)) {
+                vencedora = t;
+            }
+        }
+        if (vencedora >= 0 && melhorQue(areas[vencedora]->melhor, melhorSol)) {
+            // Troca de buffers: a melhor do bloco é descartada no próximo bloco
+            int alphaBloco = (int)(alphas[idxAlphas[areas[vencedora]->iteracaoMelhor]] * 100);
+            swap(melhorSol, areas[vencedora]->melhor);
+            melhorSol.alphaMelhor = alphaBloco;
+        }
+        
+        if (tamanho == tamBloco) {
+            atualizarProbabilidades(vezesUsado, somaQualidades, probabilidades);
+        }
+    }
+    
+    // Libera as threads
+    terminou = true;
+    barreira.aguardar();
+    for (thread& th : threads) {
+        th.join();
+    }
+    if (tamanhoElite > 0) {
+        for (int t = 1; t < totalThreads; t++) {
+            areas[0]->elite->mesclar(*areas[t]->elite);
         }
+        intensificarElite(*areas[0]->elite, melhorSol, controle, inicio);
+    }
+    for (AreaTrabalho* area : areas) {
+        INSTR_ACUMULAR(instrumentacao, area->contadores);
+        delete area;
     }
     
-    melhorSol.mediaIteracoes = somaTodasIteracoes / numIteracoes;
+    melhorSol.mediaIteracoes = somaTodasIteracoes / totalExecutadas;
+    melhorSol.iteracoesExecutadas = totalExecutadas;
+    melhorSol.criterioParada = controle.getMotivo();
     
+    restaurarRotulos(melhorSol);
     auto fim = chrono::high_resolution_clock::now();
     melhorSol.tempoExecucao = chrono::duration<double>(fim - inicio).count();
     
-    // Imprime estatisticas dos alphas
-    cout << "\n=== Estatisticas dos Alphas ===" << endl;
-    for (int i = 0; i < numAlphas; i++) {
-        cout << "Alpha " << fixed << setprecision(2) << alphas[i] 
-             << ": usado " << vezesUsado[i] << " vezes, ";
-        if (vezesUsado[i] > 0) {
-            cout << "qualidade media = " << setprecision(2) 
-                 << (somaQualidades[i] / vezesUsado[i]) << endl;
-        } else {
-            cout << "nao foi usado" << endl;
-        }
+    if (!silencioso) {
+        imprimirEstatisticasAlphas(alphas, vezesUsado, somaQualidades);
     }
     
     return melhorSol;
@@ -312,6 +1228,15 @@ Solucao ColoracaoDefeituosa::algoritmoReativo(int numIteracoes, int tamBloco) {
 void ColoracaoDefeituosa::imprimirSolucao(const Solucao& sol) {
     cout << "\n=== SOLUCAO ===" << endl;
     cout << "Numero de cores: " << sol.numCores << endl;
+    if (limiteInferior > 0) {
+        cout << "Limite inferior: " << limiteInferior;
+        if (sol.valida && sol.numCores <= limiteInferior) {
+            cout << " (solucao otima)";
+        } else {
+            cout << " (diferenca: " << sol.numCores - limiteInferior << ")";
+        }
+        cout << endl;
+    }
     cout << "Numero de deficiencias: " << sol.numDeficiencias << endl;
     cout << "Tempo de execucao: " << fixed << setprecision(4) << sol.tempoExecucao << " segundos" << endl;
     
@@ -324,41 +1249,59 @@ void ColoracaoDefeituosa::imprimirSolucao(const Solucao& sol) {
              << sol.mediaIteracoes << endl;
     }
     
-    cout << "\nColoracao dos vertices:" << endl;
-    for (size_t i = 0; i < sol.cores.size(); i++) {
-        cout << "Vertice " << i << ": cor " << sol.cores[i] << endl;
+    if (!sol.criterioParada.empty()) {
+        cout << "Iteracoes executadas: " << sol.iteracoesExecutadas
+             << " (parada: " << sol.criterioParada << ")" << endl;
     }
     
-    if (validarSolucao(sol)) {
+    // Listagem por vértice (omitida no modo silencioso): formatada em blocos
+    // e gravada pela thread de escrita, sem descarregar a cada linha
+    if (!silencioso) {
+        cout << "\nColoracao dos vertices:" << endl;
+        EscritorAssincrono saida;
+        saida.abrirSaidaPadrao();
+        for (size_t i = 0; i < sol.cores.size(); i++) {
+            saida.escrever("Vertice ");
+            saida.escreverInteiro(i);
+            saida.escrever(": cor ");
+            saida.escreverInteiro(sol.cores[i]);
+            saida.escreverCaractere('\n');
+        }
+        saida.fechar();
+    }
+    
+#ifdef VERIFICAR_SOLUCOES
+    verificarAvaliacao(sol);
+#endif
+    
+    if (sol.valida) {
         cout << "\n[OK] Solucao valida!" << endl;
     } else {
         cout << "\n[ERRO] Solucao invalida!" << endl;
     }
+    
+    if (Instrumentacao::habilitada()) {
+        Instrumentacao::imprimir(cout, instrumentacao);
+    }
 }
 
 // Exporta solução para formato GraphEditor
 void ColoracaoDefeituosa::exportarSolucaoGraphEditor(const Solucao& sol, const string& nomeArquivo) {
-    ofstream arquivo(nomeArquivo);
+    INSTR_ESCOPO(instrumentacao);
+    INSTR_FASE(FASE_ESCRITA);
+    EscritorAssincrono arquivo;
     
-    if (!arquivo.is_open()) {
+    if (!arquivo.abrir(nomeArquivo)) {
         cerr << "Erro ao criar arquivo: " << nomeArquivo << endl;
         return;
     }
     
-    int n = grafo.getNumVertices();
-    set<pair<int, int>> arestasProcessadas;
-    
-    // Escreve arestas
-    for (int u = 0; u < n; u++) {
-        for (int v : grafo.getAdjacentes(u)) {
-            if (arestasProcessadas.find({min(u, v), max(u, v)}) == arestasProcessadas.end()) {
-                arquivo << u << " " << v << endl;
-                arestasProcessadas.insert({min(u, v), max(u, v)});
-            }
-        }
-    }
+    grafo.escreverArestas(arquivo, rotulosOriginais.empty() ? nullptr : &rotulosOriginais);
     
-    arquivo.close();
+    if (!arquivo.fechar()) {
+        cerr << "Erro ao gravar arquivo: " << nomeArquivo << endl;
+        return;
+    }
     cout << "Solucao exportada para " << nomeArquivo << " (formato GraphEditor)" << endl;
 }
 
@@ -366,52 +1309,248 @@ void ColoracaoDefeituosa::exportarSolucaoGraphEditor(const Solucao& sol, const s
 void ColoracaoDefeituosa::salvarCSV(const Solucao& sol, const string& nomeInstancia, 
                                      const string& algoritmo, double alpha, int numIteracoes, 
                                      int tamBloco, unsigned int semente) {
-    ofstream arquivo;
-    
-    // Verifica se arquivo já existe
-    ifstream teste("resultados.csv");
-    bool arquivoExiste = teste.good();
-    teste.close();
+    string chave = chaveCSV(nomeInstancia, algoritmo, alpha, numIteracoes, tamBloco, semente);
+    if (!gravarLinhaCSV("resultados.csv", cabecalhoCSV(), linhaCSV(sol, chave))) {
+        cerr << "Erro ao abrir arquivo CSV" << endl;
+        return;
+    }
+    cout << "Resultado salvo em resultados.csv" << endl;
     
-    arquivo.open("resultados.csv", ios::app);
+    if (Instrumentacao::habilitada()) {
+        salvarInstrumentacao("resultados.csv", chave);
+    }
+}
+
+// Acrescenta linhas a um CSV, escrevendo o cabeçalho se o arquivo é novo
+bool ColoracaoDefeituosa::gravarLinhaCSV(const string& nomeArquivo, const string& cabecalho,
+                                         const string& linhas) {
+    INSTR_ESCOPO(instrumentacao);
+    INSTR_FASE(FASE_ESCRITA);
+    // Uma única abertura, já no fim do arquivo: vazio = arquivo novo
+    ofstream arquivo(nomeArquivo, ios::app | ios::ate);
     
     if (!arquivo.is_open()) {
-        cerr << "Erro ao abrir arquivo CSV" << endl;
-        return;
+        return false;
     }
     
     // Escreve cabeçalho se arquivo é novo
-    if (!arquivoExiste) {
-        arquivo << "Data/Hora,Instancia,Algoritmo,Parametro_d,Alpha,NumIteracoes,TamanhoBloco,"
-                << "Semente,Tempo(s),NumCores,NumDeficiencias,AlphaMelhor,MediaIteracoes" << endl;
+    string conteudo;
+    if (arquivo.tellp() == 0) {
+        conteudo = cabecalho + "\n";
     }
+    conteudo += linhas;
+    conteudo += '\n';
+    arquivo.write(conteudo.data(), conteudo.size());
     
-    // Pega data/hora atual
+    arquivo.close();
+    return !arquivo.fail();
+}
+
+// Grava os contadores e os traços das execuções ao lado do CSV de resultados
+void ColoracaoDefeituosa::salvarInstrumentacao(const string& arquivoResultados, const string& chave) {
+    string nomeContadores = Instrumentacao::arquivoDerivado(arquivoResultados, "instrumentacao");
+    if (!gravarLinhaCSV(nomeContadores,
+                        cabecalhoChaveCSV() + "," + Instrumentacao::cabecalhoContadores(),
+                        chave + "," + Instrumentacao::linhaContadores(instrumentacao))) {
+        cerr << "Erro ao abrir " << nomeContadores << endl;
+        return;
+    }
+    
+    if (!instrumentacao.tracos.empty()) {
+        string nomeTracos = Instrumentacao::arquivoDerivado(arquivoResultados, "tracos");
+        string linhas;
+        for (size_t i = 0; i < instrumentacao.tracos.size(); i++) {
+            if (i > 0) {
+                linhas += "\n";
+            }
+            linhas += chave + "," + Instrumentacao::linhaTraco(instrumentacao.tracos[i]);
+        }
+        if (!gravarLinhaCSV(nomeTracos, cabecalhoChaveCSV() + "," + Instrumentacao::cabecalhoTraco(),
+                            linhas)) {
+            cerr << "Erro ao abrir " << nomeTracos << endl;
+            return;
+        }
+    }
+    cout << "Instrumentacao salva em " << nomeContadores << endl;
+}
+
+// Cabeçalho do arquivo binário de solução. Seguem numVertices cores de
+// larguraCor bytes cada (1, 2 ou 4, a menor que comporta numCores), na
+// ordem de bytes da máquina.
+struct CabecalhoSolucao {
+    char magica[4];            // "CDSB"
+    uint32_t versao;
+    uint32_t larguraCor;
+    int32_t numVertices;
+    int32_t numCores;
+    int32_t numDeficiencias;
+    int32_t d;
+    int32_t reservado;
+};
+
+// 2: sem o tempo de execução no cabeçalho (colorações iguais, arquivos iguais)
+static const uint32_t VERSAO_SOLUCAO = 2;
+
+// Grava a solução no formato binário compacto
+bool ColoracaoDefeituosa::salvarSolucaoBinaria(const Solucao& sol, const string& nomeArquivo) {
+    INSTR_ESCOPO(instrumentacao);
+    INSTR_FASE(FASE_ESCRITA);
+    EscritorAssincrono arquivo;
+    if (!arquivo.abrir(nomeArquivo)) {
+        cerr << "Erro ao criar arquivo: " << nomeArquivo << endl;
+        return false;
+    }
+    
+    CabecalhoSolucao cab;
+    memcpy(cab.magica, "CDSB", 4);
+    cab.versao = VERSAO_SOLUCAO;
+    cab.larguraCor = (sol.numCores <= 256) ? 1 : (sol.numCores <= 65536) ? 2 : 4;
+    cab.numVertices = sol.cores.size();
+    cab.numCores = sol.numCores;
+    cab.numDeficiencias = sol.numDeficiencias;
+    cab.d = d;
+    cab.reservado = 0;
+    arquivo.escrever(reinterpret_cast<const char*>(&cab), sizeof(cab));
+    
+    if (cab.larguraCor == 4) {
+        arquivo.escrever(reinterpret_cast<const char*>(sol.cores.data()),
+                         sol.cores.size() * sizeof(int));
+    } else {
+        // Estreita as cores em lotes pequenos antes de entregá-las ao escritor
+        char lote[4096];
+        size_t usados = 0;
+        for (int cor : sol.cores) {
+            if (cab.larguraCor == 1) {
+                uint8_t c = (uint8_t)cor;
+                memcpy(lote + usados, &c, 1);
+            } else {
+                uint16_t c = (uint16_t)cor;
+                memcpy(lote + usados, &c, 2);
+            }
+            usados += cab.larguraCor;
+            if (usados + 2 > sizeof(lote)) {
+                arquivo.escrever(lote, usados);
+                usados = 0;
+            }
+        }
+        arquivo.escrever(lote, usados);
+    }
+    
+    if (!arquivo.fechar()) {
+        cerr << "Erro ao gravar arquivo: " << nomeArquivo << endl;
+        return false;
+    }
+    cout << "Solucao salva em " << nomeArquivo << " (" << cab.larguraCor << " byte(s) por cor)" << endl;
+    
+#ifdef VERIFICAR_SOLUCOES
+    // Relê o arquivo e confere com a solução gravada
+    Solucao relida;
+    if (!lerSolucaoBinaria(nomeArquivo, relida) || relida.cores != sol.cores ||
+        relida.numCores != sol.numCores || relida.numDeficiencias != sol.numDeficiencias) {
+        cerr << "[VERIFICAR] solucao binaria relida de " << nomeArquivo << " difere da gravada" << endl;
+        return false;
+    }
+#endif
+    return true;
+}
+
+// Lê uma solução gravada por salvarSolucaoBinaria
+bool ColoracaoDefeituosa::lerSolucaoBinaria(const string& nomeArquivo, Solucao& sol) {
+    ifstream arquivo(nomeArquivo, ios::binary);
+    CabecalhoSolucao cab;
+    if (!arquivo.read(reinterpret_cast<char*>(&cab), sizeof(cab)) ||
+        memcmp(cab.magica, "CDSB", 4) != 0 || cab.versao != VERSAO_SOLUCAO ||
+        (cab.larguraCor != 1 && cab.larguraCor != 2 && cab.larguraCor != 4) ||
+        cab.numVertices < 0) {
+        return false;
+    }
+    
+    vector<char> bytes((size_t)cab.numVertices * cab.larguraCor);
+    if (!arquivo.read(bytes.data(), bytes.size())) {
+        return false;
+    }
+    sol.cores.resize(cab.numVertices);
+    for (int v = 0; v < cab.numVertices; v++) {
+        const char* p = bytes.data() + (size_t)v * cab.larguraCor;
+        if (cab.larguraCor == 1) {
+            sol.cores[v] = (uint8_t)*p;
+        } else if (cab.larguraCor == 2) {
+            uint16_t c;
+            memcpy(&c, p, 2);
+            sol.cores[v] = c;
+        } else {
+            memcpy(&sol.cores[v], p, 4);
+        }
+    }
+    sol.numCores = cab.numCores;
+    sol.numDeficiencias = cab.numDeficiencias;
+    return true;
+}
+
+// Cabeçalho do CSV de resultados
+string ColoracaoDefeituosa::cabecalhoCSV() {
+    return cabecalhoChaveCSV() + ",Tempo(s),NumCores,NumDeficiencias,AlphaMelhor,MediaIteracoes,"
+           "Threads,BuscaLocal,IteracoesExecutadas,CriterioParada,Construcao,Reordenacao,Elite,"
+           "LimiteInferior,Decomposicao";
+}
+
+// Colunas que identificam uma execução
+string ColoracaoDefeituosa::cabecalhoChaveCSV() {
+    return "Data/Hora,Instancia,Algoritmo,Parametro_d,Alpha,NumIteracoes,TamanhoBloco,Semente";
+}
+
+// Chave da execução (sem a vírgula final); pode ser chamada de várias threads
+string ColoracaoDefeituosa::chaveCSV(const string& nomeInstancia, const string& algoritmo,
+                                     double alpha, int numIteracoes, int tamBloco,
+                                     unsigned int semente) const {
+    // Pega data/hora atual (localtime_r: sem o buffer estático compartilhado)
     time_t now = time(0);
-    tm* ltm = localtime(&now);
-    
-    arquivo << fixed << setprecision(4);
-    arquivo << (1900 + ltm->tm_year) << "-" 
-            << setfill('0') << setw(2) << (1 + ltm->tm_mon) << "-"
-            << setfill('0') << setw(2) << ltm->tm_mday << " "
-            << setfill('0') << setw(2) << ltm->tm_hour << ":"
-            << setfill('0') << setw(2) << ltm->tm_min << ":"
-            << setfill('0') << setw(2) << ltm->tm_sec << ",";
-    arquivo << nomeInstancia << ",";
-    arquivo << algoritmo << ",";
-    arquivo << d << ",";
-    arquivo << alpha << ",";
-    arquivo << numIteracoes << ",";
-    arquivo << tamBloco << ",";
-    arquivo << semente << ",";
-    arquivo << sol.tempoExecucao << ",";
-    arquivo << sol.numCores << ",";
-    arquivo << sol.numDeficiencias << ",";
-    arquivo << (sol.alphaMelhor / 100.0) << ",";
-    arquivo << sol.mediaIteracoes << endl;
+    tm data;
+#ifdef _WIN32
+    localtime_s(&data, &now);
+#else
+    localtime_r(&now, &data);
+#endif
+    tm* ltm = &data;
     
-    arquivo.close();
-    cout << "Resultado salvo em resultados.csv" << endl;
+    ostringstream linha;
+    linha << fixed << setprecision(4);
+    linha << (1900 + ltm->tm_year) << "-" 
+          << setfill('0') << setw(2) << (1 + ltm->tm_mon) << "-"
+          << setfill('0') << setw(2) << ltm->tm_mday << " "
+          << setfill('0') << setw(2) << ltm->tm_hour << ":"
+          << setfill('0') << setw(2) << ltm->tm_min << ":"
+          << setfill('0') << setw(2) << ltm->tm_sec << ",";
+    linha << nomeInstancia << ",";
+    linha << algoritmo << ",";
+    linha << d << ",";
+    linha << alpha << ",";
+    linha << numIteracoes << ",";
+    linha << tamBloco << ",";
+    linha << semente;
+    return linha.str();
+}
+
+// Uma linha do CSV (sem a quebra de linha): a chave seguida dos resultados
+string ColoracaoDefeituosa::linhaCSV(const Solucao& sol, const string& chave) const {
+    ostringstream linha;
+    linha << fixed << setprecision(4);
+    linha << chave << ",";
+    linha << sol.tempoExecucao << ",";
+    linha << sol.numCores << ",";
+    linha << sol.numDeficiencias << ",";
+    linha << (sol.alphaMelhor / 100.0) << ",";
+    linha << sol.mediaIteracoes << ",";
+    linha << numThreads << ",";
+    linha << iteracoesBuscaLocal << ",";
+    linha << sol.iteracoesExecutadas << ",";
+    linha << sol.criterioParada << ",";
+    linha << nomeConstrucao(construcao) << ",";
+    linha << Grafo::nomeReordenacao(reordenacao) << ",";
+    linha << tamanhoElite << ",";
+    linha << limiteInferior << ",";
+    linha << nomeDecomposicao();
+    return linha.str();
 }
 
 // Valida solução
@@ -425,21 +1564,45 @@ bool ColoracaoDefeituosa::validarSolucao(const Solucao& sol) {
         }
     }
     
+    // Cores nos identificadores internos (a solução usa os originais)
+    vector<int> cores;
+    if (!rotulosOriginais.empty()) {
+        cores.resize(n);
+        for (int v = 0; v < n; v++) {
+            cores[v] = sol.cores[rotulosOriginais[v]];
+        }
+    }
+    
     // Verifica se cada vértice respeita a restrição d
+    EstadoColoracao estado(grafo, d);
+    estado.carregar(rotulosOriginais.empty() ? sol.cores : cores);
+    
     for (int v = 0; v < n; v++) {
-        int deficiencias = 0;
-        const vector<int>& vizinhos = grafo.getAdjacentes(v);
-        
-        for (int u : vizinhos) {
-            if (sol.cores[v] == sol.cores[u]) {
-                deficiencias++;
-            }
-        }
-        
-        if (deficiencias > d) {
+        if (estado.getDeficiencias(v) > d) {
             return false;
         }
     }
     
     return true;
 }
+
+// Confere a avaliação incremental com a varredura completa das arestas
+bool ColoracaoDefeituosa::verificarAvaliacao(const Solucao& sol) {
+    int n = grafo.getNumVertices();
+    vector<int> cores(sol.cores);
+    if (!rotulosOriginais.empty()) {
+        for (int v = 0; v < n; v++) {
+            cores[v] = sol.cores[rotulosOriginais[v]];
+        }
+    }
+    
+    int deficiencias = calcularDeficiencias(cores);
+    bool valida = validarSolucao(sol);
+    bool confere = deficiencias == sol.numDeficiencias && valida == sol.valida;
+    if (!confere) {
+        cerr << "[VERIFICACAO] Avaliacao incremental diverge: deficiencias " << sol.numDeficiencias
+             << " (varredura: " << deficiencias << "), valida " << sol.valida
+             << " (varredura: " << valida << ")" << endl;
+    }
+    return confere;
+}
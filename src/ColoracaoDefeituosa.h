@@ -2,12 +2,21 @@
 #define COLORACAO_DEFEITUOSA_H
 
 #include "Grafo.h"
+#include "EstadoColoracao.h"
+#include "FilaCandidatos.h"
+#include "FilaSaturacao.h"
+#include "BuscaLocal.h"
+#include "ControleParada.h"
+#include "Instrumentacao.h"
+#include "GeradorAleatorio.h"
 #include <vector>
-#include <set>
 #include <string>
+#include <functional>
 
 using namespace std;
 
+class PoolElite;
+
 struct Solucao {
     vector<int> cores;           // cores[v] = cor do vértice v
     int numCores;                 // número de cores utilizadas
@@ -15,26 +24,183 @@ struct Solucao {
     double tempoExecucao;         // tempo de execução em segundos
     int alphaMelhor;              // alpha que gerou melhor solução (para reativo)
     double mediaIteracoes;        // média dos valores em todas as iterações
+    int iteracoesExecutadas;      // iterações realmente executadas
+    string criterioParada;        // critério que encerrou a execução
+    bool valida;                  // todos coloridos, no máximo d deficiências por vértice
+    
+    Solucao() : numCores(0), numDeficiencias(0), tempoExecucao(0.0), alphaMelhor(-1), mediaIteracoes(0.0),
+                iteracoesExecutadas(0), valida(false) {}
+};
+
+// Ordem em que a construção (gulosa ou GRASP) escolhe os vértices
+enum Construcao {
+    CONSTRUCAO_GRAU,          // grau decrescente (ordem fixa)
+    CONSTRUCAO_DSATUR,        // saturação defeituosa decrescente (dinâmica)
+    CONSTRUCAO_SMALLEST_LAST  // ordem smallest-last (fixa)
+};
+
+// Área de trabalho de uma thread do GRASP: estado, fila de candidatos,
+// busca local e as soluções corrente e melhor são alocados uma única vez e
+// reaproveitados em todas as iterações. A melhor solução é atualizada por
+// troca com a corrente, sem copiar o vetor de cores.
+struct AreaTrabalho {
+    EstadoColoracao estado;
+    FilaCandidatos fila;
+    FilaSaturacao* saturacao; // fila da construção DSATUR (nullptr nas ordens fixas)
+    BuscaLocal* busca;      // nullptr se a busca local estiver desligada
+    PoolElite* elite;       // candidatas à elite da thread (nullptr sem --elite)
+    Solucao atual;          // solução da iteração corrente
+    Solucao melhor;         // melhor solução desde reiniciarMelhor()
+    int iteracaoMelhor;     // iteração que gerou a melhor (-1 se nenhuma)
+    ContadoresInstrumentacao contadores; // instrumentação da thread (-DINSTRUMENTACAO)
+    
+    AreaTrabalho(const Grafo& g, int d, const FilaCandidatos& filaBase, FilaSaturacao* s,
+                 BuscaLocal* b, PoolElite* e);
+    ~AreaTrabalho();
+    
+    // Descarta a melhor solução
+    void reiniciarMelhor();
     
-    Solucao() : numCores(0), numDeficiencias(0), tempoExecucao(0.0), alphaMelhor(-1), mediaIteracoes(0.0) {}
+    // A solução corrente passa a ser a melhor (troca de buffers)
+    void promoverAtual(int iteracao);
+    
+private:
+    AreaTrabalho(const AreaTrabalho&);
+    AreaTrabalho& operator=(const AreaTrabalho&);
 };
 
 class ColoracaoDefeituosa {
 private:
     const Grafo& grafo;
     int d;  // parâmetro d - número máximo de deficiências permitidas por vértice
+    int numThreads;         // threads do GRASP
+    unsigned int semente;   // semente dos fluxos aleatórios (um por iteração)
+    int iteracoesBuscaLocal; // iterações tabu da busca local (0 = desligada)
+    bool silencioso;        // não imprime relatórios intermediários
+    CriterioParada criterioParada; // parada antecipada do GRASP / Reativo
+    Construcao construcao;  // ordem dos vértices na construção do GRASP / Reativo
+    ContadoresInstrumentacao instrumentacao; // acumulada desde a criação (-DINSTRUMENTACAO)
+    Reordenacao reordenacao; // renumeração aplicada ao grafo (--reordenar)
+    vector<int> rotulosOriginais; // identificador original de cada vértice (vazio sem reordenação)
+    int tamanhoElite;       // soluções da elite (0 = sem religação de caminhos)
+    int limiteInferior;     // limite inferior calculado (0 = desconhecido)
+    bool separarComponentes; // resolve os componentes conexos à parte (--componentes)
+    bool podarVertices;     // colore por último os vértices de grau baixo (--podar)
     
     // Funções auxiliares
     int calcularDeficiencias(const vector<int>& cores);
     int contarDeficienciasVertice(int v, const vector<int>& cores);
-    bool verificarRestricaoD(int v, int cor, const vector<int>& cores);
+    static bool melhorQue(const Solucao& a, const Solucao& b);
+    vector<int> calcularGraus();
+    
+    // Chaves da fila de candidatos conforme a construção (grau ou posição smallest-last)
+    vector<int> chavesConstrucao();
+    
+    // Devolve as cores da solução aos identificadores originais dos vértices
+    void restaurarRotulos(Solucao& sol) const;
+    
+    // Fecha uma construção gulosa: cores, deficiências e busca local
+    void concluirGuloso(Solucao& sol, const EstadoColoracao& estado, int corAtual);
+    
+    // Busca local da execução (nullptr se desligada) e sua aplicação
+    BuscaLocal* criarBuscaLocal();
+    void melhorarSolucao(Solucao& sol, BuscaLocal* busca, uint64_t sementeBusca);
+    
+    // Área de trabalho de uma thread (liberada pelo chamador)
+    AreaTrabalho* criarAreaTrabalho(const FilaCandidatos& filaBase);
+    
+    // Critério de parada das construções: com a elite, parte do orçamento
+    // de tempo fica reservada para a religação de caminhos
+    CriterioParada criterioConstrucao() const;
+    
+    // Religação de caminhos entre os pares da elite, distribuídos entre as
+    // threads, após as construções (controle) iniciadas em inicio;
+    // melhorSol é substituída se alguma religação a superar
+    void intensificarElite(PoolElite& elite, Solucao& melhorSol, ControleParada& controle,
+                           chrono::high_resolution_clock::time_point inicio);
+    
+    // Decomposição (Decomposicao): cada parte é resolvida por algoritmo num
+    // ColoracaoDefeituosa próprio, com as mesmas configurações e parte das
+    // numIteracoes, e as soluções são combinadas reaproveitando as cores
+    bool decompor() const { return separarComponentes || podarVertices; }
+    Solucao resolverPorPartes(int numIteracoes,
+                              const function<Solucao(ColoracaoDefeituosa&, int)>& algoritmo);
+    
+    // Uma construção gulosa randomizada seguida da busca local, se houver,
+    // gravada em area.atual, com o fluxo aleatório da iteração
+    void construirRandomizado(double alpha, AreaTrabalho& area, GeradorAleatorio& gerador);
+    template <typename Fila>
+    void construirComFila(double alpha, Fila& fila, AreaTrabalho& area, GeradorAleatorio& gerador);
+    
+    // GRASP com iterações distribuídas entre threads
+    Solucao algoritmoRandomizadoParalelo(int numIteracoes, double alpha, ControleParada& controle);
+    
+    // Auxiliares do GRASP Reativo
+    static int sortearAlpha(const vector<double>& probabilidades, double r);
+    static void atualizarProbabilidades(const vector<int>& vezesUsado,
+                                        const vector<double>& somaQualidades,
+                                        vector<double>& probabilidades);
+    static void imprimirEstatisticasAlphas(const vector<double>& alphas,
+                                           const vector<int>& vezesUsado,
+                                           const vector<double>& somaQualidades);
+    
+    // GRASP Reativo com as construções de cada bloco em paralelo
+    Solucao algoritmoReativoParalelo(int numIteracoes, int tamBloco, ControleParada& controle);
     
 public:
     ColoracaoDefeituosa(const Grafo& g, int deficiencia);
     
+    // Configuração da execução paralela
+    void setNumThreads(int threads);
+    void setSemente(unsigned int s);
+    
+    // Fase de busca local aplicada a cada solução construída (0 desliga)
+    void setBuscaLocal(int iteracoesTabu);
+    
+    // Suprime relatórios intermediários (ex.: estatísticas dos alphas) e a
+    // listagem das cores por vértice
+    void setSilencioso(bool s);
+    
+    // Critérios de parada antecipada (tempo, alvo, limite inferior, estagnação)
+    void setCriterioParada(const CriterioParada& c);
+    
+    // Conjunto elite do GRASP / Reativo e religação de caminhos (0 desliga)
+    void setElite(int tamanho);
+    
+    // Limite inferior para o número de cores (LimiteInferior::limite): é
+    // relatado junto com a solução e no CSV, e o GRASP / Reativo param ao
+    // atingi-lo (0 = desconhecido)
+    void setLimiteInferior(int limite);
+    
+    // Decomposição do grafo antes de colorir: componentes conexos resolvidos
+    // de forma independente (em paralelo, com setNumThreads) e/ou poda dos
+    // vértices de grau residual menor que o limite inferior. Vale para
+    // Guloso, DSATUR, smallest-last, GRASP e Reativo.
+    void setDecomposicao(bool componentes, bool podar);
+    string nomeDecomposicao() const;
+    
+    // Ordem dos vértices na construção do GRASP / Reativo
+    void setConstrucao(Construcao c);
+    static bool lerConstrucao(const string& nome, Construcao& c);
+    static string nomeConstrucao(Construcao c);
+    
+    // O grafo foi renumerado (Grafo::reordenar): rotulos[v] é o identificador
+    // original do vértice v. As soluções devolvidas pelos algoritmos, a
+    // validação e a exportação usam os identificadores originais.
+    void setReordenacao(Reordenacao r, const vector<int>& rotulos);
+    
     // Algoritmo Guloso
     Solucao algoritmoGuloso();
     
+    // Guloso na ordem dos vértices, para grafos mapeados do disco (--externo)
+    Solucao algoritmoGulosoExterno();
+    
+    // DSATUR defeituoso: sempre o vértice mais saturado (desempate por grau)
+    Solucao algoritmoDSatur();
+    
+    // Guloso na ordem smallest-last
+    Solucao algoritmoSmallestLast();
+    
     // Algoritmo Randomizado (GRASP)
     Solucao algoritmoRandomizado(int numIteracoes, double alpha);
     
@@ -47,12 +213,41 @@ public:
     // Exportar solução para GraphEditor
     void exportarSolucaoGraphEditor(const Solucao& sol, const string& nomeArquivo);
     
+    // Solução em formato binário compacto (cabeçalho + 1, 2 ou 4 bytes por cor)
+    bool salvarSolucaoBinaria(const Solucao& sol, const string& nomeArquivo);
+    static bool lerSolucaoBinaria(const string& nomeArquivo, Solucao& sol);
+    
     // Salvar resultado em CSV
     void salvarCSV(const Solucao& sol, const string& nomeInstancia, const string& algoritmo, 
                    double alpha, int numIteracoes, int tamBloco, unsigned int semente);
     
-    // Verificar se a solução é válida
+    // Cabeçalho e linha do CSV de resultados (usados também pelo modo em lote).
+    // A chave (data/hora até a semente) identifica a execução também nos
+    // arquivos de instrumentação.
+    static string cabecalhoCSV();
+    static string cabecalhoChaveCSV();
+    string chaveCSV(const string& nomeInstancia, const string& algoritmo, double alpha,
+                    int numIteracoes, int tamBloco, unsigned int semente) const;
+    string linhaCSV(const Solucao& sol, const string& chave) const;
+    
+    // Contadores, tempos por fase e traços das execuções deste objeto
+    ContadoresInstrumentacao& getInstrumentacao() { return instrumentacao; }
+    
+    // Grava a instrumentação ao lado do CSV de resultados:
+    // <base>_instrumentacao.csv (uma linha) e <base>_tracos.csv (uma por iteração)
+    void salvarInstrumentacao(const string& arquivoResultados, const string& chave);
+    
+    // Acrescenta linhas a um CSV, com o cabeçalho se o arquivo é novo
+    bool gravarLinhaCSV(const string& nomeArquivo, const string& cabecalho, const string& linhas);
+    
+    // Verificar se a solução é válida, por uma varredura completa das arestas
+    // (os algoritmos já entregam numDeficiencias e valida pela avaliação
+    // incremental do EstadoColoracao; esta é a conferência independente)
     bool validarSolucao(const Solucao& sol);
+    
+    // Confere numDeficiencias e valida com a varredura completa e relata
+    // divergências em cerr (chamada por imprimirSolucao com make VERIFICAR=1)
+    bool verificarAvaliacao(const Solucao& sol);
 };
 
 #endif
@@ -0,0 +1,60 @@
+#include "ControleParada.h"
+#include <climits>
+
+// Construtor: o relógio do orçamento de tempo começa aqui
+ControleParada::ControleParada(const CriterioParada& c)
+    : criterio(c), inicio(chrono::steady_clock::now()), encerrado(false),
+      motivo("iteracoes"), concluidas(0), ultimaMelhora(0),
+      melhorCores(INT_MAX), melhorDeficiencias(INT_MAX) {}
+
+// Marca a execução como encerrada (apenas o primeiro motivo é mantido)
+void ControleParada::encerrar(const string& m) {
+    if (!encerrado.load()) {
+        motivo = m;
+        encerrado.store(true);
+    }
+}
+
+// Verifica se a execução deve parar antes da próxima construção
+bool ControleParada::deveParar() {
+    if (encerrado.load(memory_order_relaxed)) {
+        return true;
+    }
+    if (criterio.tempoLimite > 0) {
+        double decorrido = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        if (decorrido >= criterio.tempoLimite) {
+            lock_guard<mutex> guarda(trava);
+            encerrar("tempo");
+            return true;
+        }
+    }
+    return false;
+}
+
+// Registra o resultado de uma iteração e avalia alvo, limite inferior e estagnação
+void ControleParada::registrar(int numCores, int numDeficiencias) {
+    lock_guard<mutex> guarda(trava);
+    concluidas++;
+
+    if (numCores < melhorCores ||
+        (numCores == melhorCores && numDeficiencias < melhorDeficiencias)) {
+        melhorCores = numCores;
+        melhorDeficiencias = numDeficiencias;
+        ultimaMelhora = concluidas;
+    }
+
+    if (criterio.limiteInferior > 0 && melhorCores <= criterio.limiteInferior) {
+        encerrar("limite_inferior");
+    } else if (criterio.alvoCores > 0 && melhorCores <= criterio.alvoCores) {
+        encerrar("alvo");
+    } else if (criterio.iteracoesSemMelhora > 0 &&
+               concluidas - ultimaMelhora >= criterio.iteracoesSemMelhora) {
+        encerrar("estagnacao");
+    }
+}
+
+// Motivo da parada
+string ControleParada::getMotivo() {
+    lock_guard<mutex> guarda(trava);
+    return motivo;
+}
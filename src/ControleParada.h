@@ -0,0 +1,58 @@
+#ifndef CONTROLE_PARADA_H
+#define CONTROLE_PARADA_H
+
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <string>
+
+using namespace std;
+
+// Critérios de parada antecipada do GRASP e do Reativo, combináveis entre
+// si e com o número máximo de iterações (valores <= 0 desligam o critério).
+struct CriterioParada {
+    double tempoLimite;        // orçamento de tempo de parede, em segundos
+    int alvoCores;             // para ao atingir numCores <= alvoCores
+    int limiteInferior;        // limite inferior conhecido (ex.: por cliques)
+    int iteracoesSemMelhora;   // para após K iterações sem melhorar a melhor solução
+
+    CriterioParada() : tempoLimite(0.0), alvoCores(0), limiteInferior(0), iteracoesSemMelhora(0) {}
+
+    bool ativo() const {
+        return tempoLimite > 0 || alvoCores > 0 || limiteInferior > 0 || iteracoesSemMelhora > 0;
+    }
+};
+
+// Estado compartilhado dos critérios de parada durante uma execução.
+// As threads consultam deveParar() antes de cada construção e registram o
+// resultado de cada iteração concluída; o primeiro critério satisfeito
+// encerra a execução e fica registrado como o motivo da parada.
+class ControleParada {
+private:
+    CriterioParada criterio;
+    chrono::steady_clock::time_point inicio;
+
+    atomic<bool> encerrado;
+    mutex trava;                // protege os campos abaixo
+    string motivo;
+    long long concluidas;       // iterações concluídas
+    long long ultimaMelhora;    // valor de concluidas na última melhora
+    int melhorCores;
+    int melhorDeficiencias;
+
+    void encerrar(const string& m);
+
+public:
+    ControleParada(const CriterioParada& c);
+
+    // true se algum critério já foi satisfeito (ou o tempo se esgotou)
+    bool deveParar();
+
+    // Registra uma iteração concluída com a qualidade da solução construída
+    void registrar(int numCores, int numDeficiencias);
+
+    // Motivo da parada: "iteracoes" se nenhum critério antecipado disparou
+    string getMotivo();
+};
+
+#endif
@@ -0,0 +1,138 @@
+#include "Decomposicao.h"
+#include <algorithm>
+
+using namespace std;
+
+// Vértices mínimos de uma parte formada por componentes pequenos agrupados
+static const int TAMANHO_MINIMO_PARTE = 256;
+
+// Poda, componentes e agrupamento em partes
+Decomposicao::Decomposicao(const Grafo& g, int d, bool separarComponentes, int limiarPoda)
+    : grafo(g), numComponentes(0) {
+    int n = g.getNumVertices();
+    vector<char> removido(n, 0);
+    vector<int> grauResidual(n);
+    for (int v = 0; v < n; v++) {
+        grauResidual[v] = g.getGrau(v);
+    }
+    if (limiarPoda >= 0) {
+        podar(limiarPoda, removido, grauResidual);
+    }
+
+    // Componentes do grafo restante, por busca em largura
+    vector<int> componente(n, -1);
+    vector<int> tamanho, grauMaximo;
+    vector<long long> arestas;
+    vector<int> fila;
+    for (int s = 0; s < n; s++) {
+        if (removido[s] || componente[s] >= 0) {
+            continue;
+        }
+        int c = numComponentes++;
+        componente[s] = c;
+        fila.clear();
+        fila.push_back(s);
+        long long pontas = 0;
+        int maior = 0;
+        for (size_t i = 0; i < fila.size(); i++) {
+            int v = fila[i];
+            pontas += grauResidual[v];
+            maior = max(maior, grauResidual[v]);
+            for (int u : g.getAdjacentes(v)) {
+                if (!removido[u] && componente[u] < 0) {
+                    componente[u] = c;
+                    fila.push_back(u);
+                }
+            }
+        }
+        tamanho.push_back(fila.size());
+        grauMaximo.push_back(maior);
+        arestas.push_back(pontas / 2);
+    }
+
+    // Parte de cada componente: os não triviais do maior para o menor,
+    // agrupando os pequenos (sem separar, todos na parte 0)
+    vector<int> parteComponente(numComponentes, -1);
+    vector<int> ordem;
+    for (int c = 0; c < numComponentes; c++) {
+        if (!separarComponentes || grauMaximo[c] > d) {
+            ordem.push_back(c);
+        }
+    }
+    stable_sort(ordem.begin(), ordem.end(), [&](int a, int b) { return tamanho[a] > tamanho[b]; });
+    vector<int> tamanhoParte;
+    for (int c : ordem) {
+        if (tamanhoParte.empty() ||
+            (separarComponentes && tamanhoParte.back() >= TAMANHO_MINIMO_PARTE)) {
+            tamanhoParte.push_back(0);
+            arestasParte.push_back(0);
+        }
+        parteComponente[c] = tamanhoParte.size() - 1;
+        tamanhoParte.back() += tamanho[c];
+        arestasParte.back() += arestas[c];
+    }
+
+    // Vértices de cada parte, em ordem crescente
+    partes.resize(tamanhoParte.size());
+    for (size_t p = 0; p < partes.size(); p++) {
+        partes[p].reserve(tamanhoParte[p]);
+    }
+    parteVertice.assign(n, -1);
+    indiceLocal.assign(n, -1);
+    for (int v = 0; v < n; v++) {
+        if (removido[v]) {
+            continue;
+        }
+        int p = parteComponente[componente[v]];
+        if (p < 0) {
+            triviais.push_back(v);
+            continue;
+        }
+        parteVertice[v] = p;
+        indiceLocal[v] = partes[p].size();
+        partes[p].push_back(v);
+    }
+}
+
+// Retira os vértices de grau residual <= limiarPoda; podados serve de fila
+void Decomposicao::podar(int limiarPoda, vector<char>& removido, vector<int>& grauResidual) {
+    int n = grafo.getNumVertices();
+    vector<char> naFila(n, 0);
+    for (int v = 0; v < n; v++) {
+        if (grauResidual[v] <= limiarPoda) {
+            naFila[v] = 1;
+            podados.push_back(v);
+        }
+    }
+    for (size_t i = 0; i < podados.size(); i++) {
+        int v = podados[i];
+        removido[v] = 1;
+        for (int u : grafo.getAdjacentes(v)) {
+            if (!removido[u]) {
+                grauResidual[u]--;
+                if (!naFila[u] && grauResidual[u] <= limiarPoda) {
+                    naFila[u] = 1;
+                    podados.push_back(u);
+                }
+            }
+        }
+    }
+}
+
+// Subgrafo induzido, com os vértices numerados pela posição na parte
+Grafo* Decomposicao::subgrafo(int p) const {
+    const vector<int>& vertices = partes[p];
+    int k = vertices.size();
+    vector<long long> inicio(k + 1, 0);
+    vector<int> adjacentes;
+    adjacentes.reserve(2 * arestasParte[p]);
+    for (int i = 0; i < k; i++) {
+        for (int u : grafo.getAdjacentes(vertices[i])) {
+            if (parteVertice[u] == p) {
+                adjacentes.push_back(indiceLocal[u]);
+            }
+        }
+        inicio[i + 1] = adjacentes.size();
+    }
+    return new Grafo(k, arestasParte[p], inicio, adjacentes);
+}
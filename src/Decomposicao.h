@@ -0,0 +1,57 @@
+#ifndef DECOMPOSICAO_H
+#define DECOMPOSICAO_H
+
+#include "Grafo.h"
+#include <vector>
+
+using namespace std;
+
+// Decomposição do grafo em partes coloridas de forma independente
+// (--componentes, --podar).
+//
+// Poda: vértices de grau residual <= limiarPoda são retirados um a um
+// (cada retirada baixa o grau dos vizinhos) e coloridos por último, na
+// ordem inversa: cada um encontra no máximo limiarPoda vizinhos já
+// coloridos e, se houver mais cores que isso, uma cor sem nenhum deles.
+// Com limiarPoda < k, sendo k um limite inferior do número de cores, a
+// poda não aumenta o número de cores além de max(cores das partes, k).
+//
+// Componentes: o grafo restante é dividido em componentes conexos (em
+// O(n + m)). Componentes de grau máximo <= d são triviais (uma cor basta);
+// os demais viram partes, da maior para a menor, e os pequenos são
+// agrupados até TAMANHO_MINIMO_PARTE vértices para que cada parte valha o
+// custo de ser resolvida à parte. Sem separar os componentes, todo o grafo
+// restante é uma única parte.
+//
+// Os vértices de cada parte ficam em ordem crescente, e o subgrafo
+// induzido numera-os nessa ordem (as linhas do CSR continuam ordenadas).
+class Decomposicao {
+private:
+    const Grafo& grafo;
+    vector<int> podados;            // vértices podados, na ordem de retirada
+    vector<int> triviais;           // vértices dos componentes triviais
+    vector<vector<int>> partes;     // vértices de cada parte (crescentes)
+    vector<long long> arestasParte;
+    vector<int> parteVertice;       // parte de cada vértice (-1 se podado ou trivial)
+    vector<int> indiceLocal;        // posição do vértice na sua parte
+    int numComponentes;
+
+    void podar(int limiarPoda, vector<char>& removido, vector<int>& grauResidual);
+
+public:
+    // Com limiarPoda < 0 não há poda
+    Decomposicao(const Grafo& g, int d, bool separarComponentes, int limiarPoda);
+
+    int getNumPartes() const { return partes.size(); }
+    int getNumComponentes() const { return numComponentes; }
+    const vector<int>& getParte(int p) const { return partes[p]; }
+    long long getArestasParte(int p) const { return arestasParte[p]; }
+    const vector<int>& getPodados() const { return podados; }
+    const vector<int>& getTriviais() const { return triviais; }
+
+    // Subgrafo induzido pela parte, já congelado (liberado pelo chamador).
+    // Pode ser chamado de várias threads.
+    Grafo* subgrafo(int p) const;
+};
+
+#endif
@@ -0,0 +1,220 @@
+#include "EscritorAssincrono.h"
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <climits>
+#endif
+
+// Construtor
+EscritorAssincrono::EscritorAssincrono()
+    : descritor(-1), fecharDescritor(false), falhou(false), encerrando(false) {}
+
+// Destrutor
+EscritorAssincrono::~EscritorAssincrono() {
+    fechar();
+}
+
+// Cria ou trunca o arquivo e inicia a thread de escrita
+bool EscritorAssincrono::abrir(const string& nomeArquivo) {
+    fechar();
+#ifdef _WIN32
+    int fd = _open(nomeArquivo.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,
+                   _S_IREAD | _S_IWRITE);
+#else
+    int fd = open(nomeArquivo.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    if (fd < 0) {
+        return false;
+    }
+    iniciar(fd, true);
+    return true;
+}
+
+// Escreve na saída padrão (não é fechada ao final)
+bool EscritorAssincrono::abrirSaidaPadrao() {
+    fechar();
+    iniciar(1, false);
+    return true;
+}
+
+void EscritorAssincrono::iniciar(int fd, bool proprio) {
+    descritor = fd;
+    fecharDescritor = proprio;
+    falhou = false;
+    encerrando = false;
+    atual.clear();
+    atual.reserve(TAMANHO_BLOCO);
+    escritora = thread(&EscritorAssincrono::gravar, this);
+}
+
+// Entrega o bloco atual à thread de escrita e passa a formatar num bloco livre
+void EscritorAssincrono::entregar() {
+    if (atual.empty()) {
+        return;
+    }
+    unique_lock<mutex> guarda(trava);
+    temEspaco.wait(guarda, [this]() { return pendentes.size() < MAX_PENDENTES; });
+    pendentes.push_back(string());
+    pendentes.back().swap(atual);
+    if (!livres.empty()) {
+        atual.swap(livres.back());
+        livres.pop_back();
+    } else {
+        atual.reserve(TAMANHO_BLOCO);
+    }
+    temPendente.notify_one();
+}
+
+// Laço da thread de escrita: grava de uma vez todos os blocos pendentes
+void EscritorAssincrono::gravar() {
+    deque<string> lote;
+    unique_lock<mutex> guarda(trava);
+    while (true) {
+        temPendente.wait(guarda, [this]() { return !pendentes.empty() || encerrando; });
+        if (pendentes.empty()) {
+            return;
+        }
+        lote.swap(pendentes);
+        guarda.unlock();
+
+        bool ok = gravarLote(lote);
+
+        guarda.lock();
+        if (!ok) {
+            falhou = true;
+        }
+        for (string& bloco : lote) {
+            bloco.clear();
+            livres.push_back(string());
+            livres.back().swap(bloco);
+        }
+        lote.clear();
+        temEspaco.notify_all();
+    }
+}
+
+// Grava os blocos em ordem, retomando gravações parciais
+bool EscritorAssincrono::gravarLote(deque<string>& lote) {
+#ifdef _WIN32
+    for (const string& bloco : lote) {
+        size_t feito = 0;
+        while (feito < bloco.size()) {
+            int escrito = _write(descritor, bloco.data() + feito, (unsigned int)(bloco.size() - feito));
+            if (escrito <= 0) {
+                return false;
+            }
+            feito += escrito;
+        }
+    }
+    return true;
+#else
+    size_t indice = 0;      // primeiro bloco ainda não gravado por inteiro
+    size_t deslocamento = 0; // bytes já gravados desse bloco
+    while (indice < lote.size()) {
+        iovec partes[64];
+        int numPartes = 0;
+        for (size_t i = indice; i < lote.size() && numPartes < 64 && numPartes < IOV_MAX; i++) {
+            size_t pular = (i == indice) ? deslocamento : 0;
+            partes[numPartes].iov_base = const_cast<char*>(lote[i].data()) + pular;
+            partes[numPartes].iov_len = lote[i].size() - pular;
+            numPartes++;
+        }
+        ssize_t escrito = writev(descritor, partes, numPartes);
+        if (escrito < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        // Avança sobre os bytes gravados
+        size_t restante = escrito;
+        while (indice < lote.size() && restante >= lote[indice].size() - deslocamento) {
+            restante -= lote[indice].size() - deslocamento;
+            deslocamento = 0;
+            indice++;
+        }
+        deslocamento += restante;
+    }
+    return true;
+#endif
+}
+
+// Acrescenta bytes ao bloco atual, entregando-o sempre que encher
+void EscritorAssincrono::escrever(const char* dados, size_t tamanho) {
+    while (tamanho > 0) {
+        size_t parte = min(tamanho, TAMANHO_BLOCO - min(atual.size(), TAMANHO_BLOCO));
+        if (parte == 0) {
+            entregar();
+            continue;
+        }
+        atual.append(dados, parte);
+        dados += parte;
+        tamanho -= parte;
+    }
+    if (atual.size() >= TAMANHO_BLOCO) {
+        entregar();
+    }
+}
+
+void EscritorAssincrono::escrever(const char* texto) {
+    escrever(texto, strlen(texto));
+}
+
+void EscritorAssincrono::escreverCaractere(char c) {
+    atual.push_back(c);
+    if (atual.size() >= TAMANHO_BLOCO) {
+        entregar();
+    }
+}
+
+// Inteiro em decimal, sem passar por streams
+void EscritorAssincrono::escreverInteiro(long long x) {
+    char digitos[24];
+    int pos = sizeof(digitos);
+    unsigned long long valor = (x < 0) ? 0ULL - (unsigned long long)x : (unsigned long long)x;
+    do {
+        digitos[--pos] = (char)('0' + valor % 10);
+        valor /= 10;
+    } while (valor != 0);
+    if (x < 0) {
+        digitos[--pos] = '-';
+    }
+    escrever(digitos + pos, sizeof(digitos) - pos);
+}
+
+// Grava o que resta e encerra a thread
+bool EscritorAssincrono::fechar() {
+    if (descritor < 0) {
+        return !falhou;
+    }
+    entregar();
+    {
+        lock_guard<mutex> guarda(trava);
+        encerrando = true;
+    }
+    temPendente.notify_one();
+    escritora.join();
+
+    if (fecharDescritor) {
+#ifdef _WIN32
+        if (_close(descritor) != 0) {
+            falhou = true;
+        }
+#else
+        if (close(descritor) != 0) {
+            falhou = true;
+        }
+#endif
+    }
+    descritor = -1;
+    return !falhou;
+}
@@ -0,0 +1,67 @@
+#ifndef ESCRITOR_ASSINCRONO_H
+#define ESCRITOR_ASSINCRONO_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+using namespace std;
+
+// Saída em blocos grandes gravados por uma thread de escrita em segundo
+// plano. O produtor formata num bloco de memória (sem descarregar a cada
+// linha) e, quando ele enche, entrega-o à thread de escrita e segue
+// formatando no próximo; a thread grava todos os blocos pendentes de uma
+// vez (writev). No máximo MAX_PENDENTES blocos aguardam gravação: um
+// produtor mais rápido que o disco espera, e a memória fica limitada.
+// Os blocos gravados são reaproveitados, sem novas alocações.
+class EscritorAssincrono {
+private:
+    static const size_t TAMANHO_BLOCO = 1 << 20;
+    static const size_t MAX_PENDENTES = 4;
+
+    int descritor;          // -1 se fechado
+    bool fecharDescritor;   // false para a saída padrão
+    bool falhou;            // alguma gravação falhou
+
+    string atual;           // bloco em formatação
+    deque<string> pendentes;
+    vector<string> livres;  // blocos já gravados, para reaproveitar
+    bool encerrando;
+    mutex trava;
+    condition_variable temPendente;
+    condition_variable temEspaco;
+    thread escritora;
+
+    void iniciar(int fd, bool proprio);
+    void entregar();
+    void gravar();
+    bool gravarLote(deque<string>& lote);
+
+    EscritorAssincrono(const EscritorAssincrono&);
+    EscritorAssincrono& operator=(const EscritorAssincrono&);
+
+public:
+    EscritorAssincrono();
+    ~EscritorAssincrono();
+
+    // Cria (ou trunca) o arquivo
+    bool abrir(const string& nomeArquivo);
+
+    // Usa a saída padrão (quem já escreveu em cout deve descarregá-lo antes)
+    bool abrirSaidaPadrao();
+
+    void escrever(const char* dados, size_t tamanho);
+    void escrever(const char* texto);
+    void escrever(const string& texto) { escrever(texto.data(), texto.size()); }
+    void escreverCaractere(char c);
+    void escreverInteiro(long long x);
+
+    // Grava o restante, encerra a thread e fecha o arquivo.
+    // Retorna false se alguma gravação falhou.
+    bool fechar();
+};
+
+#endif
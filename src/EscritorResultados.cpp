@@ -0,0 +1,58 @@
+#include "EscritorResultados.h"
+
+// Construtor
+EscritorResultados::EscritorResultados(const string& nome)
+    : nomeArquivo(nome), linhasEscritas(0) {
+    buffer.reserve(TAMANHO_BUFFER + 1024);
+}
+
+// Destrutor: nada escrito fica para trás
+EscritorResultados::~EscritorResultados() {
+    descarregar();
+}
+
+// Abre o CSV; o cabeçalho entra se o arquivo ainda não tem conteúdo
+bool EscritorResultados::abrir(const string& cabecalho) {
+    ifstream teste(nomeArquivo, ios::ate);
+    bool vazio = !teste.good() || teste.tellg() <= 0;
+    teste.close();
+
+    arquivo.open(nomeArquivo, ios::app);
+    if (!arquivo.is_open()) {
+        return false;
+    }
+    if (vazio) {
+        arquivo << cabecalho << "\n";
+    }
+    return true;
+}
+
+// Acrescenta uma linha ao buffer
+void EscritorResultados::escrever(const string& linha) {
+    lock_guard<mutex> guarda(trava);
+    buffer += linha;
+    buffer += '\n';
+    linhasEscritas++;
+    if (buffer.size() >= TAMANHO_BUFFER) {
+        descarregarSemTrava();
+    }
+}
+
+void EscritorResultados::descarregarSemTrava() {
+    if (!buffer.empty() && arquivo.is_open()) {
+        arquivo.write(buffer.data(), buffer.size());
+        arquivo.flush();
+    }
+    buffer.clear();
+}
+
+// Grava o buffer no arquivo
+void EscritorResultados::descarregar() {
+    lock_guard<mutex> guarda(trava);
+    descarregarSemTrava();
+}
+
+long long EscritorResultados::getLinhasEscritas() {
+    lock_guard<mutex> guarda(trava);
+    return linhasEscritas;
+}
@@ -0,0 +1,46 @@
+#ifndef ESCRITOR_RESULTADOS_H
+#define ESCRITOR_RESULTADOS_H
+
+#include <fstream>
+#include <mutex>
+#include <string>
+
+using namespace std;
+
+// Escritor único do CSV de resultados, compartilhado pelas execuções de um
+// lote: as linhas se acumulam num buffer em memória (protegido por mutex) e
+// vão para o arquivo, aberto uma única vez, a cada TAMANHO_BUFFER bytes e
+// ao final. O cabeçalho só é escrito se o arquivo for novo ou vazio.
+class EscritorResultados {
+private:
+    string nomeArquivo;
+    ofstream arquivo;
+    string buffer;
+    long long linhasEscritas;
+    mutex trava;
+
+    static const size_t TAMANHO_BUFFER = 1 << 16;
+
+    void descarregarSemTrava();
+
+    EscritorResultados(const EscritorResultados&);
+    EscritorResultados& operator=(const EscritorResultados&);
+
+public:
+    EscritorResultados(const string& nome);
+    ~EscritorResultados();
+
+    // Abre o arquivo em modo de acréscimo; retorna false se não for possível
+    bool abrir(const string& cabecalho);
+
+    // Acrescenta uma linha (sem a quebra de linha); segura entre threads
+    void escrever(const string& linha);
+
+    // Grava o buffer no arquivo
+    void descarregar();
+
+    long long getLinhasEscritas();
+    const string& getNomeArquivo() const { return nomeArquivo; }
+};
+
+#endif
@@ -0,0 +1,247 @@
+#include "EstadoColoracao.h"
+#include "KernelBits.h"
+#include "Instrumentacao.h"
+#include <algorithm>
+
+// Construtor
+EstadoColoracao::EstadoColoracao(const Grafo& g, int deficiencia)
+    : grafo(g), d(deficiencia), arestasMonocromaticas(0), excesso(0), verticesExcedentes(0),
+      verticesColoridos(0), palavras(0), coresComBits(0) {
+    int n = grafo.getNumVertices();
+    cores.assign(n, -1);
+    deficiencias.assign(n, 0);
+    
+    // Uma construção nunca abre mais que (grau máximo + 1) cores: reservar o
+    // rascunho por cor aqui evita realocações durante as iterações
+    int grauMaximo = 0;
+    for (int v = 0; v < n; v++) {
+        grauMaximo = max(grauMaximo, grafo.getGrau(v));
+    }
+    vizinhosNaCor.reserve(grauMaximo + 2);
+    corBloqueada.reserve(grauMaximo + 2);
+    tamanhoClasse.reserve(grauMaximo + 2);
+    coresTocadas.reserve(grauMaximo + 1);
+    
+    if (grafo.temMatrizBits()) {
+        palavras = grafo.getPalavrasPorLinha();
+        saturadosBits.assign(palavras, 0);
+        classesBits.reserve((size_t)(grauMaximo + 2) * palavras);
+    }
+}
+
+// Garante que o rascunho por cor comporte a cor informada
+void EstadoColoracao::garantirCor(int cor) {
+    if ((int)vizinhosNaCor.size() <= cor) {
+        vizinhosNaCor.resize(cor + 1, 0);
+        corBloqueada.resize(cor + 1, 0);
+        tamanhoClasse.resize(cor + 1, 0);
+    }
+    if (palavras > 0 && coresComBits <= cor) {
+        coresComBits = cor + 1;
+        classesBits.resize((size_t)coresComBits * palavras, 0);
+    }
+}
+
+// Mantém o bit de v na linha dos saturados
+void EstadoColoracao::atualizarSaturado(int v) {
+    uint64_t bit = 1ULL << (v & 63);
+    if (cores[v] != -1 && deficiencias[v] >= d) {
+        saturadosBits[v >> 6] |= bit;
+    } else {
+        saturadosBits[v >> 6] &= ~bit;
+    }
+}
+
+// Descolore todos os vértices
+void EstadoColoracao::reiniciar() {
+    fill(cores.begin(), cores.end(), -1);
+    fill(deficiencias.begin(), deficiencias.end(), 0);
+    fill(tamanhoClasse.begin(), tamanhoClasse.end(), 0);
+    arestasMonocromaticas = 0;
+    excesso = 0;
+    verticesExcedentes = 0;
+    verticesColoridos = 0;
+    if (palavras > 0) {
+        fill(classesBits.begin(), classesBits.end(), 0);
+        fill(saturadosBits.begin(), saturadosBits.end(), 0);
+    }
+}
+
+// Carrega uma coloração completa e recalcula as deficiências e a avaliação
+void EstadoColoracao::carregar(const vector<int>& novasCores) {
+    int n = grafo.getNumVertices();
+    cores = novasCores;
+
+    for (int v = 0; v < n; v++) {
+        garantirCor(cores[v]);
+    }
+
+    fill(tamanhoClasse.begin(), tamanhoClasse.end(), 0);
+    long long pontas = 0; // pontas de arestas monocromáticas (sem laços)
+    excesso = 0;
+    verticesExcedentes = 0;
+    verticesColoridos = 0;
+    for (int v = 0; v < n; v++) {
+        int total = 0;
+        if (cores[v] != -1) {
+            for (int u : grafo.getAdjacentes(v)) {
+                if (cores[u] == cores[v]) {
+                    total++;
+                    pontas += (u != v);
+                }
+            }
+            tamanhoClasse[cores[v]]++;
+            verticesColoridos++;
+        }
+        deficiencias[v] = total;
+        excesso += max(0, total - d);
+        verticesExcedentes += (total > d);
+    }
+    arestasMonocromaticas = pontas / 2;
+
+    if (palavras > 0) {
+        fill(classesBits.begin(), classesBits.end(), 0);
+        for (int v = 0; v < n; v++) {
+            if (cores[v] != -1) {
+                classe(cores[v])[v >> 6] |= 1ULL << (v & 63);
+            }
+            atualizarSaturado(v);
+        }
+    }
+}
+
+// Menor cor em [0, maxCor] que v pode receber
+int EstadoColoracao::menorCorViavel(int v, int maxCor) {
+    garantirCor(maxCor);
+
+    if (palavras > 0) {
+        const uint64_t* linha = grafo.getLinhaBits(v);
+        for (int cor = 0; cor <= maxCor; cor++) {
+            INSTR_CONTAR(verificacoesCor, 1);
+            if (KernelBits::corViavel(linha, classe(cor), saturadosBits.data(), palavras, d)) {
+                return cor;
+            }
+        }
+        return -1;
+    }
+
+    // Agrega, por cor, quantos vizinhos a usam e se algum deles já está saturado
+    INSTR_CONTAR(visitasVizinhos, grafo.getGrau(v));
+    for (int u : grafo.getAdjacentes(v)) {
+        int c = cores[u];
+        if (c < 0) {
+            continue;
+        }
+        if (vizinhosNaCor[c] == 0) {
+            coresTocadas.push_back(c);
+        }
+        vizinhosNaCor[c]++;
+        if (deficiencias[u] >= d) {
+            corBloqueada[c] = 1;
+        }
+    }
+
+    int escolhida = -1;
+    for (int cor = 0; cor <= maxCor; cor++) {
+        if (!corBloqueada[cor] && vizinhosNaCor[cor] <= d) {
+            escolhida = cor;
+            break;
+        }
+    }
+    INSTR_CONTAR(verificacoesCor, (escolhida < 0) ? maxCor + 1 : escolhida + 1);
+
+    // Limpa o rascunho apenas nas cores usadas
+    for (int c : coresTocadas) {
+        vizinhosNaCor[c] = 0;
+        corBloqueada[c] = 0;
+    }
+    coresTocadas.clear();
+
+    return escolhida;
+}
+
+// Backend denso: percorre os bits de (linha de v AND classe da cor)
+void EstadoColoracao::ajustarDeficiencias(int v, int cor, int delta) {
+    const uint64_t* linha = grafo.getLinhaBits(v);
+    const uint64_t* membros = classe(cor);
+    for (int i = 0; i < palavras; i++) {
+        uint64_t comum = linha[i] & membros[i];
+        while (comum != 0) {
+            int u = i * 64 + __builtin_ctzll(comum);
+            comum &= comum - 1;
+            somarDeficiencia(u, delta);
+            somarDeficiencia(v, delta);
+            arestasMonocromaticas += delta;
+            atualizarSaturado(u);
+        }
+    }
+}
+
+// Atribui cor a v e atualiza as deficiências de v e dos vizinhos com a mesma cor
+void EstadoColoracao::colorir(int v, int cor) {
+    garantirCor(cor);
+    cores[v] = cor;
+    tamanhoClasse[cor]++;
+    verticesColoridos++;
+
+    if (palavras > 0) {
+        ajustarDeficiencias(v, cor, 1);
+        classe(cor)[v >> 6] |= 1ULL << (v & 63);
+        atualizarSaturado(v);
+        return;
+    }
+
+    INSTR_CONTAR(visitasVizinhos, grafo.getGrau(v));
+    for (int u : grafo.getAdjacentes(v)) {
+        if (cores[u] != cor) {
+            continue;
+        }
+        if (u == v) {
+            somarDeficiencia(v, 1); // laço: cada ocorrência conta uma vez
+        } else {
+            somarDeficiencia(u, 1);
+            somarDeficiencia(v, 1);
+            arestasMonocromaticas++;
+        }
+    }
+}
+
+// Retira a cor de v, desfazendo as deficiências com os vizinhos de mesma cor
+void EstadoColoracao::descolorir(int v) {
+    int cor = cores[v];
+    if (cor == -1) {
+        return;
+    }
+
+    tamanhoClasse[cor]--;
+    verticesColoridos--;
+
+    if (palavras > 0) {
+        classe(cor)[v >> 6] &= ~(1ULL << (v & 63));
+        ajustarDeficiencias(v, cor, -1);
+        cores[v] = -1;
+        atualizarSaturado(v);
+        return;
+    }
+
+    INSTR_CONTAR(visitasVizinhos, grafo.getGrau(v));
+    for (int u : grafo.getAdjacentes(v)) {
+        if (cores[u] != cor) {
+            continue;
+        }
+        if (u == v) {
+            somarDeficiencia(v, -1);
+        } else {
+            somarDeficiencia(u, -1);
+            somarDeficiencia(v, -1);
+            arestasMonocromaticas--;
+        }
+    }
+    cores[v] = -1;
+}
+
+// Troca a cor de v
+void EstadoColoracao::recolorir(int v, int cor) {
+    descolorir(v);
+    colorir(v, cor);
+}
@@ -0,0 +1,115 @@
+#ifndef ESTADO_COLORACAO_H
+#define ESTADO_COLORACAO_H
+
+#include "Grafo.h"
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+
+// Estado incremental de uma coloração defeituosa em construção.
+// Mantém as cores e o número de deficiências de cada vértice, atualizados
+// em O(grau) a cada vértice colorido, de modo que a pergunta "v pode receber
+// a cor c?" não precisa reexaminar a vizinhança dos vizinhos.
+//
+// O estado também avalia a coloração incrementalmente: total de arestas
+// monocromáticas, excesso (soma das deficiências acima de d), vértices
+// acima de d e tamanho de cada classe de cor são atualizados junto com as
+// deficiências, em O(grau) por alteração, e consultados em O(1), sem
+// reexaminar as arestas ao final de cada construção.
+//
+// Um vértice v (ainda sem cor) pode receber a cor c se:
+//  - no máximo d vizinhos de v já têm a cor c; e
+//  - nenhum desses vizinhos já atingiu d deficiências.
+//
+// Se o grafo tem matriz de bits (backend denso), o estado mantém também uma
+// linha de bits por cor (os vértices da classe) e a linha dos vértices
+// saturados (com d ou mais deficiências); a consulta passa a ser feita por
+// KernelBits sobre essas linhas, com o mesmo resultado das listas.
+class EstadoColoracao {
+private:
+    const Grafo& grafo;
+    int d;
+    vector<int> cores;          // cores[v] = cor do vértice v (-1 se não colorido)
+    vector<int> deficiencias;   // deficiencias[v] = vizinhos de v com a mesma cor de v
+
+    // Avaliação incremental
+    long long arestasMonocromaticas; // arestas (sem laços) com as duas pontas da mesma cor
+    long long excesso;          // soma de max(0, deficiencias[v] - d)
+    int verticesExcedentes;     // vértices com mais de d deficiências
+    int verticesColoridos;
+    vector<int> tamanhoClasse;  // tamanhoClasse[c] = vértices com a cor c
+
+    // Rascunho indexado por cor, reaproveitado entre consultas
+    vector<int> vizinhosNaCor;  // vizinhos do vértice consultado com cada cor
+    vector<char> corBloqueada;  // cor possui vizinho que já atingiu d deficiências
+    vector<int> coresTocadas;   // cores modificadas no rascunho (para limpeza)
+
+    // Backend denso (palavras = 0 quando desligado)
+    int palavras;                   // palavras de 64 bits por linha
+    int coresComBits;               // cores com linha alocada em classesBits
+    vector<uint64_t> classesBits;   // linha da cor c em [c * palavras, (c + 1) * palavras)
+    vector<uint64_t> saturadosBits; // vértices coloridos com deficiencias >= d
+
+    void garantirCor(int cor);
+
+    uint64_t* classe(int cor) { return classesBits.data() + (size_t)cor * palavras; }
+    void atualizarSaturado(int v);
+
+    // Soma delta às deficiências de u, mantendo o excesso e os excedentes
+    void somarDeficiencia(int u, int delta) {
+        int antes = deficiencias[u];
+        int depois = antes + delta;
+        deficiencias[u] = depois;
+        excesso += max(0, depois - d) - max(0, antes - d);
+        verticesExcedentes += (depois > d) - (antes > d);
+    }
+
+    // Soma delta às deficiências de v e dos vizinhos de v com a cor informada
+    void ajustarDeficiencias(int v, int cor, int delta);
+
+public:
+    EstadoColoracao(const Grafo& g, int deficiencia);
+
+    // Descolore todos os vértices
+    void reiniciar();
+
+    // Carrega uma coloração completa, recalculando as deficiências em O(n + m)
+    void carregar(const vector<int>& novasCores);
+
+    // Menor cor em [0, maxCor] que v pode receber, ou -1 se nenhuma.
+    // Percorre a vizinhança de v uma única vez: O(grau + maxCor).
+    int menorCorViavel(int v, int maxCor);
+
+    // Atribui a cor ao vértice (não colorido) v e atualiza as deficiências em O(grau)
+    void colorir(int v, int cor);
+
+    // Retira a cor de v e atualiza as deficiências em O(grau)
+    void descolorir(int v);
+
+    // Troca a cor de v em O(grau)
+    void recolorir(int v, int cor);
+
+    int getCor(int v) const { return cores[v]; }
+    int getDeficiencias(int v) const { return deficiencias[v]; }
+    const vector<int>& getCores() const { return cores; }
+
+    // Avaliação da coloração corrente, em O(1)
+    int totalDeficiencias() const { return (int)arestasMonocromaticas; } // arestas monocromáticas
+    long long getExcesso() const { return excesso; }
+    int getVerticesExcedentes() const { return verticesExcedentes; }
+    int getTamanhoClasse(int cor) const {
+        return (cor < (int)tamanhoClasse.size()) ? tamanhoClasse[cor] : 0;
+    }
+
+    // Todos os vértices coloridos, nenhum com mais de d deficiências
+    bool valida() const {
+        return verticesColoridos == (int)cores.size() && verticesExcedentes == 0;
+    }
+
+    // Indica se as consultas usam o backend denso
+    bool usaBits() const { return palavras > 0; }
+};
+
+#endif
@@ -0,0 +1,410 @@
+#include "ExecutorLote.h"
+#include "Grafo.h"
+#include "LeitorInstancia.h"
+#include "PoolTarefas.h"
+#include "EscritorResultados.h"
+#include "Instrumentacao.h"
+#include "LimiteInferior.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <cstdlib>
+#include <climits>
+
+// Valores padrão: GRASP com alpha 0.5, 100 iterações, semente 1
+ManifestoLote::ManifestoLote()
+    : valoresD(1, 1), algoritmos(1, "grasp"), alphas(1, 0.5), iteracoes(1, 100), blocos(1, 10),
+      sementes(1, 1), threads(1, 1), construcoes(1, CONSTRUCAO_GRAU), buscaLocal(0),
+      elite(0), saida("resultados.csv"), trabalhadores(0), usarCache(true),
+      calcularLimite(true), componentes(false), podar(false) {}
+
+// Uma execução do lote
+struct ExecucaoLote {
+    int instancia;
+    int d;
+    string algoritmo;
+    double alpha;
+    int iteracoes;
+    int bloco;
+    unsigned int semente;
+    int threads;
+    Construcao construcao;
+    double custo;       // estimativa: (n + m) * iterações
+};
+
+static bool deterministico(const string& algoritmo) {
+    return algoritmo == "guloso" || algoritmo == "dsatur" || algoritmo == "smallestlast";
+}
+
+// Nome do algoritmo na coluna Algoritmo do CSV (como no modo de linha de comando)
+static string nomeCSV(const string& algoritmo) {
+    if (algoritmo == "guloso") return "Guloso";
+    if (algoritmo == "dsatur") return "DSATUR";
+    if (algoritmo == "smallestlast") return "SmallestLast";
+    if (algoritmo == "grasp") return "GRASP";
+    return "Reativo";
+}
+
+// Separa os valores de uma linha do manifesto
+static vector<string> separarValores(const string& texto) {
+    string limpo = texto;
+    replace(limpo.begin(), limpo.end(), ',', ' ');
+    istringstream entrada(limpo);
+    vector<string> valores;
+    string valor;
+    while (entrada >> valor) {
+        valores.push_back(valor);
+    }
+    return valores;
+}
+
+// Converte um valor numérico; false se for inválido
+template <typename T>
+static bool converterValor(const string& valor, T& destino) {
+    istringstream entrada(valor);
+    T x;
+    if (!(entrada >> x) || !entrada.eof()) {
+        return false;
+    }
+    destino = x;
+    return true;
+}
+
+// Converte uma lista de valores numéricos; false se algum for inválido
+template <typename T>
+static bool converterLista(const vector<string>& valores, vector<T>& destino) {
+    vector<T> lidos;
+    for (const string& valor : valores) {
+        T x;
+        if (!converterValor(valor, x)) {
+            return false;
+        }
+        lidos.push_back(x);
+    }
+    destino = lidos;
+    return true;
+}
+
+// Todos os valores em [minimo, maximo]
+template <typename T>
+static bool noIntervalo(const vector<T>& valores, T minimo, T maximo) {
+    for (const T& x : valores) {
+        if (x < minimo || x > maximo) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Valor 0 / 1 de uma chave booleana
+static bool converterBooleano(const string& valor, bool& destino) {
+    int x;
+    if (!converterValor(valor, x)) {
+        return false;
+    }
+    destino = x != 0;
+    return true;
+}
+
+// Lê o manifesto
+bool ExecutorLote::lerManifesto(const string& nomeArquivo, ManifestoLote& manifesto, string& erro) {
+    ifstream arquivo(nomeArquivo);
+    if (!arquivo.is_open()) {
+        erro = "erro ao abrir " + nomeArquivo;
+        return false;
+    }
+
+    manifesto = ManifestoLote();
+    string linha;
+    int numeroLinha = 0;
+    while (getline(arquivo, linha)) {
+        numeroLinha++;
+        size_t comentario = linha.find('#');
+        if (comentario != string::npos) {
+            linha.erase(comentario);
+        }
+        if (linha.find_first_not_of(" \t\r") == string::npos) {
+            continue;
+        }
+
+        ostringstream local;
+        local << nomeArquivo << ":" << numeroLinha << ": ";
+        size_t igual = linha.find('=');
+        if (igual == string::npos) {
+            erro = local.str() + "esperado \"chave = valores\"";
+            return false;
+        }
+        vector<string> chave = separarValores(linha.substr(0, igual));
+        vector<string> valores = separarValores(linha.substr(igual + 1));
+        if (chave.size() != 1 || valores.empty()) {
+            erro = local.str() + "esperado \"chave = valores\"";
+            return false;
+        }
+
+        const string& c = chave[0];
+        bool ok = true;
+        if (c == "instancias") {
+            manifesto.instancias = valores;
+        } else if (c == "d") {
+            ok = converterLista(valores, manifesto.valoresD) &&
+                 noIntervalo(manifesto.valoresD, 0, INT_MAX);
+        } else if (c == "algoritmos") {
+            for (const string& a : valores) {
+                ok = ok && (deterministico(a) || a == "grasp" || a == "reativo");
+            }
+            manifesto.algoritmos = valores;
+        } else if (c == "alphas") {
+            ok = converterLista(valores, manifesto.alphas) && noIntervalo(manifesto.alphas, 0.0, 1.0);
+        } else if (c == "iteracoes") {
+            ok = converterLista(valores, manifesto.iteracoes) &&
+                 noIntervalo(manifesto.iteracoes, 1, INT_MAX);
+        } else if (c == "blocos") {
+            ok = converterLista(valores, manifesto.blocos) && noIntervalo(manifesto.blocos, 1, INT_MAX);
+        } else if (c == "sementes") {
+            ok = converterLista(valores, manifesto.sementes);
+        } else if (c == "threads") {
+            ok = converterLista(valores, manifesto.threads) &&
+                 noIntervalo(manifesto.threads, 1, INT_MAX);
+        } else if (c == "construcoes") {
+            manifesto.construcoes.clear();
+            for (const string& nome : valores) {
+                Construcao construcao;
+                ok = ok && ColoracaoDefeituosa::lerConstrucao(nome, construcao);
+                manifesto.construcoes.push_back(construcao);
+            }
+        } else if (c == "busca_local" && valores.size() == 1) {
+            ok = converterValor(valores[0], manifesto.buscaLocal) && manifesto.buscaLocal >= 0;
+        } else if (c == "elite" && valores.size() == 1) {
+            ok = converterValor(valores[0], manifesto.elite) && manifesto.elite >= 0;
+        } else if (c == "tempo" && valores.size() == 1) {
+            ok = converterValor(valores[0], manifesto.criterio.tempoLimite);
+        } else if (c == "alvo" && valores.size() == 1) {
+            ok = converterValor(valores[0], manifesto.criterio.alvoCores);
+        } else if (c == "estagnacao" && valores.size() == 1) {
+            ok = converterValor(valores[0], manifesto.criterio.iteracoesSemMelhora);
+        } else if (c == "saida" && valores.size() == 1) {
+            manifesto.saida = valores[0];
+        } else if (c == "trabalhadores" && valores.size() == 1) {
+            ok = converterValor(valores[0], manifesto.trabalhadores);
+        } else if (c == "cache" && valores.size() == 1) {
+            ok = converterBooleano(valores[0], manifesto.usarCache);
+        } else if (c == "limite" && valores.size() == 1) {
+            ok = converterBooleano(valores[0], manifesto.calcularLimite);
+        } else if (c == "componentes" && valores.size() == 1) {
+            ok = converterBooleano(valores[0], manifesto.componentes);
+        } else if (c == "podar" && valores.size() == 1) {
+            ok = converterBooleano(valores[0], manifesto.podar);
+        } else {
+            erro = local.str() + "chave desconhecida ou com mais de um valor: " + c;
+            return false;
+        }
+        if (!ok) {
+            erro = local.str() + "valor invalido para " + c;
+            return false;
+        }
+    }
+
+    if (manifesto.instancias.empty()) {
+        erro = nomeArquivo + ": nenhuma instancia (chave \"instancias\")";
+        return false;
+    }
+    return true;
+}
+
+// Executa o lote
+int ExecutorLote::executar(const ManifestoLote& m) {
+    auto inicio = chrono::steady_clock::now();
+
+    // Cada instância é lida uma única vez e compartilhada pelas execuções,
+    // assim como os invariantes do seu limite inferior
+    vector<Grafo*> grafos(m.instancias.size(), nullptr);
+    vector<LimiteInferior*> limites(m.instancias.size(), nullptr);
+    int falhas = 0;
+    for (size_t i = 0; i < m.instancias.size(); i++) {
+        RelatorioLeitura relatorio;
+        grafos[i] = Grafo::lerArquivo(m.instancias[i], relatorio, m.usarCache);
+        if (relatorio.temProblemas()) {
+            relatorio.imprimir(cerr, m.instancias[i]);
+        }
+        if (grafos[i] == nullptr) {
+            cerr << "Erro ao carregar instancia " << m.instancias[i] << "; execucoes ignoradas" << endl;
+            falhas++;
+            continue;
+        }
+        cout << "Instancia " << m.instancias[i] << ": " << grafos[i]->getNumVertices()
+             << " vertices, " << grafos[i]->getNumArestas() << " arestas";
+        if (m.calcularLimite) {
+            limites[i] = new LimiteInferior(*grafos[i]);
+            cout << ", clique " << (limites[i]->isCliqueExato() ? "maximo " : "heuristico ")
+                 << limites[i]->getClique();
+        }
+        cout << endl;
+    }
+
+    // Produto cartesiano dos parâmetros; os algoritmos determinísticos só
+    // variam com a semente quando há busca local
+    vector<ExecucaoLote> execucoes;
+    for (size_t i = 0; i < grafos.size(); i++) {
+        if (grafos[i] == nullptr) {
+            continue;
+        }
+        double tamanho = (double)grafos[i]->getNumVertices() + grafos[i]->getNumArestas();
+        for (int d : m.valoresD) {
+            for (const string& algoritmo : m.algoritmos) {
+                ExecucaoLote e;
+                e.instancia = i;
+                e.d = d;
+                e.algoritmo = algoritmo;
+                e.alpha = -1;
+                e.iteracoes = 0;
+                e.bloco = 0;
+                e.threads = 1;
+                e.construcao = CONSTRUCAO_GRAU;
+
+                if (deterministico(algoritmo)) {
+                    size_t numSementes = (m.buscaLocal > 0) ? m.sementes.size() : 1;
+                    for (size_t s = 0; s < numSementes; s++) {
+                        e.semente = m.sementes[s];
+                        e.custo = tamanho;
+                        execucoes.push_back(e);
+                    }
+                    continue;
+                }
+
+                vector<double> alphas = (algoritmo == "grasp") ? m.alphas : vector<double>(1, -1);
+                vector<int> blocos = (algoritmo == "reativo") ? m.blocos : vector<int>(1, 0);
+                for (double alpha : alphas) {
+                    for (int bloco : blocos) {
+                        for (int iteracoes : m.iteracoes) {
+                            for (int threads : m.threads) {
+                                for (Construcao construcao : m.construcoes) {
+                                    for (unsigned int semente : m.sementes) {
+                                        e.alpha = alpha;
+                                        e.bloco = bloco;
+                                        e.iteracoes = iteracoes;
+                                        e.threads = threads;
+                                        e.construcao = construcao;
+                                        e.semente = semente;
+                                        e.custo = tamanho * max(iteracoes, 1);
+                                        execucoes.push_back(e);
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // As mais caras primeiro: cada trabalhador começa por elas e os roubos
+    // do fim do lote pegam as mais baratas
+    stable_sort(execucoes.begin(), execucoes.end(),
+                [](const ExecucaoLote& a, const ExecucaoLote& b) { return a.custo > b.custo; });
+
+    EscritorResultados escritor(m.saida);
+    if (!escritor.abrir(ColoracaoDefeituosa::cabecalhoCSV())) {
+        cerr << "Erro ao abrir " << m.saida << endl;
+        for (size_t i = 0; i < grafos.size(); i++) {
+            delete grafos[i];
+            delete limites[i];
+        }
+        return 1;
+    }
+
+    // Com -DINSTRUMENTACAO, contadores e traços de cada execução vão para
+    // <saida>_instrumentacao.csv e <saida>_tracos.csv, com a mesma chave
+    EscritorResultados escritorContadores(Instrumentacao::arquivoDerivado(m.saida, "instrumentacao"));
+    EscritorResultados escritorTracos(Instrumentacao::arquivoDerivado(m.saida, "tracos"));
+    if (Instrumentacao::habilitada()) {
+        string chave = ColoracaoDefeituosa::cabecalhoChaveCSV() + ",";
+        if (!escritorContadores.abrir(chave + Instrumentacao::cabecalhoContadores()) ||
+            !escritorTracos.abrir(chave + Instrumentacao::cabecalhoTraco())) {
+            cerr << "Erro ao abrir os arquivos de instrumentacao" << endl;
+        }
+    }
+    
+    PoolTarefas pool(m.trabalhadores);
+    int total = execucoes.size();
+    cout << "Lote: " << total << " execucoes em " << pool.getNumTrabalhadores()
+         << " trabalhador(es)" << endl;
+
+    atomic<int> concluidas(0);
+    mutex travaProgresso;
+    for (int k = 0; k < total; k++) {
+        pool.adicionar([&, k]() {
+            const ExecucaoLote& e = execucoes[k];
+            const string& instancia = m.instancias[e.instancia];
+
+            ColoracaoDefeituosa coloracao(*grafos[e.instancia], e.d);
+            coloracao.setSemente(e.semente);
+            coloracao.setNumThreads(e.threads);
+            coloracao.setBuscaLocal(m.buscaLocal);
+            coloracao.setElite(m.elite);
+            coloracao.setCriterioParada(m.criterio);
+            if (limites[e.instancia] != nullptr) {
+                coloracao.setLimiteInferior(limites[e.instancia]->limite(e.d));
+            }
+            coloracao.setConstrucao(e.construcao);
+            coloracao.setDecomposicao(m.componentes, m.podar);
+            coloracao.setSilencioso(true);
+
+            Solucao sol;
+            if (e.algoritmo == "guloso") {
+                sol = coloracao.algoritmoGuloso();
+            } else if (e.algoritmo == "dsatur") {
+                coloracao.setConstrucao(CONSTRUCAO_DSATUR);
+                sol = coloracao.algoritmoDSatur();
+            } else if (e.algoritmo == "smallestlast") {
+                coloracao.setConstrucao(CONSTRUCAO_SMALLEST_LAST);
+                sol = coloracao.algoritmoSmallestLast();
+            } else if (e.algoritmo == "grasp") {
+                sol = coloracao.algoritmoRandomizado(e.iteracoes, e.alpha);
+            } else {
+                sol = coloracao.algoritmoReativo(e.iteracoes, e.bloco);
+            }
+
+            string chave = coloracao.chaveCSV(instancia, nomeCSV(e.algoritmo), e.alpha, e.iteracoes,
+                                              e.bloco, e.semente);
+            escritor.escrever(coloracao.linhaCSV(sol, chave));
+            if (Instrumentacao::habilitada()) {
+                const ContadoresInstrumentacao& c = coloracao.getInstrumentacao();
+                escritorContadores.escrever(chave + "," + Instrumentacao::linhaContadores(c));
+                for (const TracoIteracao& traco : c.tracos) {
+                    escritorTracos.escrever(chave + "," + Instrumentacao::linhaTraco(traco));
+                }
+            }
+
+            int feitas = ++concluidas;
+            lock_guard<mutex> guarda(travaProgresso);
+            cerr << "[" << feitas << "/" << total << "] " << instancia << " d=" << e.d << " "
+                 << nomeCSV(e.algoritmo);
+            if (e.alpha >= 0) {
+                cerr << " alpha=" << e.alpha;
+            }
+            cerr << " semente=" << e.semente << ": " << sol.numCores << " cores, "
+                 << fixed << setprecision(3) << sol.tempoExecucao << " s" << endl;
+        });
+    }
+    pool.executar();
+    escritor.descarregar();
+    if (Instrumentacao::habilitada()) {
+        escritorContadores.descarregar();
+        escritorTracos.descarregar();
+    }
+
+    double decorrido = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    cout << "Lote concluido: " << escritor.getLinhasEscritas() << " execucoes em " << fixed
+         << setprecision(2) << decorrido << " s; resultados em " << m.saida << endl;
+
+    for (size_t i = 0; i < grafos.size(); i++) {
+        delete grafos[i];
+        delete limites[i];
+    }
+    return falhas > 0 ? 1 : 0;
+}
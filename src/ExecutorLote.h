@@ -0,0 +1,52 @@
+#ifndef EXECUTOR_LOTE_H
+#define EXECUTOR_LOTE_H
+
+#include "ColoracaoDefeituosa.h"
+#include "ControleParada.h"
+#include <vector>
+#include <string>
+
+using namespace std;
+
+// Manifesto de um experimento em lote. Arquivo texto com linhas
+// "chave = valores" (valores separados por espaços ou vírgulas, '#' inicia
+// comentário); as execuções são o produto cartesiano das listas.
+struct ManifestoLote {
+    vector<string> instancias;
+    vector<int> valoresD;
+    vector<string> algoritmos;    // guloso, dsatur, smallestlast, grasp, reativo
+    vector<double> alphas;        // GRASP
+    vector<int> iteracoes;        // GRASP e Reativo
+    vector<int> blocos;           // Reativo
+    vector<unsigned int> sementes;
+    vector<int> threads;          // threads de cada execução do GRASP / Reativo
+    vector<Construcao> construcoes; // GRASP e Reativo
+    int buscaLocal;
+    int elite;                    // conjunto elite do GRASP / Reativo (0 = desligado)
+    CriterioParada criterio;
+    string saida;                 // CSV de resultados
+    int trabalhadores;            // execuções simultâneas (0 = núcleos)
+    bool usarCache;
+    bool calcularLimite;          // limite inferior de cada instância (LimiteInferior)
+    bool componentes;             // resolve os componentes conexos à parte
+    bool podar;                   // poda dos vértices de grau baixo
+
+    ManifestoLote();
+};
+
+// Modo em lote (--lote): carrega cada instância uma única vez, distribui as
+// execuções num PoolTarefas (roubo de tarefas, as mais caras primeiro) e
+// grava todas as linhas por um único EscritorResultados. As execuções de
+// uma instância compartilham o mesmo Grafo, só para leitura; cada uma tem
+// seu ColoracaoDefeituosa, com fluxos aleatórios próprios derivados da
+// semente, de modo que o resultado não depende do escalonamento.
+class ExecutorLote {
+public:
+    // Lê o manifesto; em caso de erro, descreve-o em erro e retorna false
+    static bool lerManifesto(const string& nomeArquivo, ManifestoLote& manifesto, string& erro);
+
+    // Executa o lote; retorna o código de saída do programa
+    static int executar(const ManifestoLote& manifesto);
+};
+
+#endif
@@ -0,0 +1,87 @@
+#include "FilaCandidatos.h"
+#include <algorithm>
+#include <functional>
+
+// Construtor: ordena os vértices por (chave, vértice) decrescente
+FilaCandidatos::FilaCandidatos(const vector<int>& chaves) {
+    n = chaves.size();
+
+    vector<pair<int, int>> pares; // (chave, vértice)
+    pares.reserve(n);
+    for (int v = 0; v < n; v++) {
+        pares.push_back({chaves[v], v});
+    }
+    sort(pares.begin(), pares.end(), greater<pair<int, int>>());
+
+    ordem.resize(n);
+    chaveOrdenada.resize(n);
+    posicao.resize(n);
+    for (int i = 0; i < n; i++) {
+        chaveOrdenada[i] = pares[i].first;
+        ordem[i] = pares[i].second;
+        posicao[ordem[i]] = i;
+    }
+
+    passoInicial = 1;
+    while (passoInicial * 2 <= n) {
+        passoInicial *= 2;
+    }
+
+    arvore.resize(n + 1);
+    reiniciar();
+}
+
+// Marca todos os vértices como restantes (árvore de Fenwick toda com 1) em O(n)
+void FilaCandidatos::reiniciar() {
+    for (int i = 1; i <= n; i++) {
+        arvore[i] = i & (-i);
+    }
+    restantes = n;
+}
+
+// Descida na árvore de Fenwick: posição do k-ésimo elemento presente
+int FilaCandidatos::posicaoKesimo(int k) const {
+    int pos = 0;
+    int resto = k + 1;
+    for (int passo = passoInicial; passo > 0; passo >>= 1) {
+        int prox = pos + passo;
+        if (prox <= n && arvore[prox] < resto) {
+            pos = prox;
+            resto -= arvore[prox];
+        }
+    }
+    return pos; // índice 0-based em ordem
+}
+
+int FilaCandidatos::chaveMaxima() const {
+    return chaveOrdenada[posicaoKesimo(0)];
+}
+
+int FilaCandidatos::chaveMinima() const {
+    return chaveOrdenada[posicaoKesimo(restantes - 1)];
+}
+
+// Conta restantes com chave >= limiar: soma de prefixo até o fim dessa faixa
+int FilaCandidatos::contarAcima(double limiar) const {
+    int fim = partition_point(chaveOrdenada.begin(), chaveOrdenada.end(),
+                              [limiar](int chave) { return chave >= limiar; })
+              - chaveOrdenada.begin();
+
+    int total = 0;
+    for (int i = fim; i > 0; i -= i & (-i)) {
+        total += arvore[i];
+    }
+    return total;
+}
+
+int FilaCandidatos::kesimo(int k) const {
+    return ordem[posicaoKesimo(k)];
+}
+
+// Remove v dos restantes
+void FilaCandidatos::remover(int v) {
+    for (int i = posicao[v] + 1; i <= n; i += i & (-i)) {
+        arvore[i]--;
+    }
+    restantes--;
+}
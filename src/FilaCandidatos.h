@@ -0,0 +1,51 @@
+#ifndef FILA_CANDIDATOS_H
+#define FILA_CANDIDATOS_H
+
+#include <vector>
+
+using namespace std;
+
+// Fila de candidatos da construção GRASP.
+// Os vértices são ordenados uma única vez por (chave, vértice) decrescente,
+// a mesma ordem usada para montar a RCL. Uma árvore de Fenwick sobre as
+// posições marca os vértices restantes, de modo que os extremos da chave,
+// o tamanho da RCL, a escolha do k-ésimo candidato e a remoção custam
+// O(log n), sem reordenar os restantes a cada passo.
+class FilaCandidatos {
+private:
+    int n;
+    int restantes;
+    int passoInicial;           // maior potência de 2 <= n (descida na árvore)
+    vector<int> ordem;          // vértices em ordem decrescente de (chave, vértice)
+    vector<int> chaveOrdenada;  // chaveOrdenada[i] = chave de ordem[i]
+    vector<int> posicao;        // posicao[v] = índice de v em ordem
+    vector<int> arvore;         // árvore de Fenwick (1-indexada) de presença
+
+    // Posição (em ordem) do k-ésimo vértice restante, k a partir de 0
+    int posicaoKesimo(int k) const;
+
+public:
+    // chaves[v] = prioridade do vértice v (ex.: grau)
+    FilaCandidatos(const vector<int>& chaves);
+
+    // Marca todos os vértices como restantes
+    void reiniciar();
+
+    bool vazia() const { return restantes == 0; }
+    int tamanho() const { return restantes; }
+
+    // Maior e menor chave entre os restantes
+    int chaveMaxima() const;
+    int chaveMinima() const;
+
+    // Número de restantes com chave >= limiar (o tamanho da RCL)
+    int contarAcima(double limiar) const;
+
+    // k-ésimo restante na ordem decrescente, k a partir de 0
+    int kesimo(int k) const;
+
+    // Remove o vértice v dos restantes
+    void remover(int v);
+};
+
+#endif
@@ -0,0 +1,277 @@
+#include "FilaSaturacao.h"
+#include <algorithm>
+#include <functional>
+#include <cmath>
+
+static const uint64_t POSICAO_VAZIA = ~0ULL;
+
+// Construtor: ordem inicial por grau, baldes e tabela de contagens
+FilaSaturacao::FilaSaturacao(const Grafo& g, int deficiencia)
+    : grafo(g), d(deficiencia), n(g.getNumVertices()), grauMaximo(0), restantes(0),
+      grau(n) {
+    vector<pair<int, int>> pares; // (grau, vértice)
+    pares.reserve(n);
+    for (int v = 0; v < n; v++) {
+        grau[v] = g.getGrau(v);
+        pares.push_back({grau[v], v});
+        grauMaximo = max(grauMaximo, grau[v]);
+    }
+    sort(pares.begin(), pares.end(), greater<pair<int, int>>());
+
+    // Em ordem decrescente o vetor já é um heap válido para o balde 0
+    ordemInicial.resize(n);
+    for (int i = 0; i < n; i++) {
+        ordemInicial[i] = pares[i].second;
+    }
+
+    // Só vértices com grau >= s chegam à saturação s: reservar essa
+    // quantidade em cada balde (n + 2m no total) evita realocações
+    vector<int> comGrauMinimo(grauMaximo + 2, 0);
+    for (int v = 0; v < n; v++) {
+        comGrauMinimo[grau[v]]++;
+    }
+    for (int s = grauMaximo - 1; s >= 0; s--) {
+        comGrauMinimo[s] += comGrauMinimo[s + 1];
+    }
+    baldes.resize(grauMaximo + 1);
+    for (int s = 0; s <= grauMaximo; s++) {
+        baldes[s].reserve(comGrauMinimo[s]);
+    }
+    saturacao.resize(n);
+    posicao.resize(n);
+    arvore.resize(grauMaximo + 2);
+
+    passoInicial = 1;
+    while (passoInicial * 2 <= grauMaximo + 1) {
+        passoInicial *= 2;
+    }
+
+    // Tabela de contagens para cerca de um par por vértice (carga <= 1/2);
+    // cresce sob demanda e guarda o tamanho entre as construções
+    uint64_t capacidade = 16;
+    deslocamentoTabela = 60;
+    while (capacidade < 2 * (uint64_t)n) {
+        capacidade *= 2;
+        deslocamentoTabela--;
+    }
+    chavesTabela.assign(capacidade, POSICAO_VAZIA);
+    contagemTabela.resize(capacidade);
+    ocupadas.reserve(capacidade / 2);
+    mascaraTabela = capacidade - 1;
+
+    reiniciar();
+}
+
+// Todos no balde 0, na ordem inicial, e tabela de contagens vazia
+void FilaSaturacao::reiniciar() {
+    for (vector<int>& balde : baldes) {
+        balde.clear();
+    }
+    baldes[0].assign(ordemInicial.begin(), ordemInicial.end());
+    for (int i = 0; i < n; i++) {
+        posicao[ordemInicial[i]] = i;
+        saturacao[ordemInicial[i]] = 0;
+    }
+
+    // Saturação zero corresponde à última posição da árvore
+    fill(arvore.begin(), arvore.end(), 0);
+    if (n > 0) {
+        somarArvore(0, n);
+    }
+    restantes = n;
+
+    for (uint64_t i : ocupadas) {
+        chavesTabela[i] = POSICAO_VAZIA;
+    }
+    ocupadas.clear();
+}
+
+// Ordem do heap: (grau, vértice) decrescente, como em FilaCandidatos
+bool FilaSaturacao::antes(int a, int b) const {
+    return grau[a] > grau[b] || (grau[a] == grau[b] && a > b);
+}
+
+void FilaSaturacao::subir(vector<int>& heap, int i) {
+    int v = heap[i];
+    while (i > 0) {
+        int pai = (i - 1) / 2;
+        if (!antes(v, heap[pai])) {
+            break;
+        }
+        heap[i] = heap[pai];
+        posicao[heap[i]] = i;
+        i = pai;
+    }
+    heap[i] = v;
+    posicao[v] = i;
+}
+
+void FilaSaturacao::descer(vector<int>& heap, int i) {
+    int tam = heap.size();
+    int v = heap[i];
+    while (true) {
+        int filho = 2 * i + 1;
+        if (filho >= tam) {
+            break;
+        }
+        if (filho + 1 < tam && antes(heap[filho + 1], heap[filho])) {
+            filho++;
+        }
+        if (!antes(heap[filho], v)) {
+            break;
+        }
+        heap[i] = heap[filho];
+        posicao[heap[i]] = i;
+        i = filho;
+    }
+    heap[i] = v;
+    posicao[v] = i;
+}
+
+void FilaSaturacao::inserirNoBalde(int v, int s) {
+    vector<int>& heap = baldes[s];
+    heap.push_back(v);
+    subir(heap, heap.size() - 1);
+}
+
+void FilaSaturacao::retirarDoBalde(int v) {
+    vector<int>& heap = baldes[saturacao[v]];
+    int i = posicao[v];
+    int ultimo = heap.back();
+    heap.pop_back();
+    if (i < (int)heap.size()) {
+        heap[i] = ultimo;
+        posicao[ultimo] = i;
+        subir(heap, i);
+        descer(heap, posicao[ultimo]);
+    }
+    posicao[v] = -1;
+}
+
+// Soma delta ao tamanho do balde s (posição grauMaximo - s + 1 na árvore)
+void FilaSaturacao::somarArvore(int s, int delta) {
+    for (int i = grauMaximo - s + 1; i <= grauMaximo + 1; i += i & (-i)) {
+        arvore[i] += delta;
+    }
+}
+
+// Descida na árvore de Fenwick até o balde que contém o k-ésimo restante
+void FilaSaturacao::localizar(int k, int& s, int& deslocamento) const {
+    int pos = 0;
+    int resto = k;
+    for (int passo = passoInicial; passo > 0; passo >>= 1) {
+        int prox = pos + passo;
+        if (prox <= grauMaximo + 1 && arvore[prox] <= resto) {
+            pos = prox;
+            resto -= arvore[prox];
+        }
+    }
+    s = grauMaximo - pos; // a posição pos + 1 corresponde à saturação grauMaximo - pos
+    deslocamento = resto;
+}
+
+int FilaSaturacao::chaveMaxima() const {
+    int s, deslocamento;
+    localizar(0, s, deslocamento);
+    return s;
+}
+
+int FilaSaturacao::chaveMinima() const {
+    int s, deslocamento;
+    localizar(restantes - 1, s, deslocamento);
+    return s;
+}
+
+// Restantes com saturação >= limiar: soma de prefixo na árvore
+int FilaSaturacao::contarAcima(double limiar) const {
+    int menor = (int)ceil(limiar);
+    if (menor <= 0) {
+        return restantes;
+    }
+    if (menor > grauMaximo) {
+        return 0;
+    }
+
+    int total = 0;
+    for (int i = grauMaximo - menor + 1; i > 0; i -= i & (-i)) {
+        total += arvore[i];
+    }
+    return total;
+}
+
+int FilaSaturacao::kesimo(int k) const {
+    int s, deslocamento;
+    localizar(k, s, deslocamento);
+    return baldes[s][deslocamento];
+}
+
+// Remove v dos restantes
+void FilaSaturacao::remover(int v) {
+    somarArvore(saturacao[v], -1);
+    retirarDoBalde(v);
+    restantes--;
+}
+
+// Sondagem linear a partir do hash multiplicativo do par (bits altos do
+// produto, que dependem de todos os bits do vértice e da cor)
+uint64_t FilaSaturacao::posicaoNaTabela(uint64_t chave) const {
+    uint64_t i = (chave * 0x9E3779B97F4A7C15ULL) >> deslocamentoTabela;
+    while (chavesTabela[i] != POSICAO_VAZIA && chavesTabela[i] != chave) {
+        i = (i + 1) & mascaraTabela;
+    }
+    return i;
+}
+
+// Dobra a capacidade; as posições ocupadas passam a ser as da nova tabela
+void FilaSaturacao::ampliarTabela() {
+    vector<uint64_t> chavesAntigas;
+    vector<int> contagensAntigas;
+    chavesAntigas.swap(chavesTabela);
+    contagensAntigas.swap(contagemTabela);
+    chavesTabela.assign(2 * chavesAntigas.size(), POSICAO_VAZIA);
+    contagemTabela.resize(chavesTabela.size());
+    mascaraTabela = chavesTabela.size() - 1;
+    deslocamentoTabela--;
+
+    for (uint64_t& ocupada : ocupadas) {
+        uint64_t chave = chavesAntigas[ocupada];
+        uint64_t i = posicaoNaTabela(chave);
+        chavesTabela[i] = chave;
+        contagemTabela[i] = contagensAntigas[ocupada];
+        ocupada = i;
+    }
+    ocupadas.reserve(chavesTabela.size() / 2);
+}
+
+int FilaSaturacao::incrementarContagem(int v, int cor) {
+    uint64_t chave = ((uint64_t)v << 32) | (uint32_t)cor;
+    uint64_t i = posicaoNaTabela(chave);
+    if (chavesTabela[i] == POSICAO_VAZIA) {
+        // Carga <= 1/2 também depois desta inserção
+        if (2 * (ocupadas.size() + 1) > chavesTabela.size()) {
+            ampliarTabela();
+            i = posicaoNaTabela(chave);
+        }
+        chavesTabela[i] = chave;
+        contagemTabela[i] = 0;
+        ocupadas.push_back(i);
+    }
+    return ++contagemTabela[i];
+}
+
+// u recebeu a cor: cada vizinho restante consome uma unidade de folga nela
+void FilaSaturacao::registrarCor(int u, int cor) {
+    for (int w : grafo.getAdjacentes(u)) {
+        if (posicao[w] < 0) {
+            continue;
+        }
+        if (incrementarContagem(w, cor) <= d + 1) {
+            int s = saturacao[w];
+            somarArvore(s, -1);
+            retirarDoBalde(w);
+            saturacao[w] = s + 1;
+            somarArvore(s + 1, 1);
+            inserirNoBalde(w, s + 1);
+        }
+    }
+}
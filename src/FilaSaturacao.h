@@ -0,0 +1,96 @@
+#ifndef FILA_SATURACAO_H
+#define FILA_SATURACAO_H
+
+#include "Grafo.h"
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+// Fila de prioridade da construção DSATUR defeituosa.
+//
+// A saturação de um vértice v não colorido soma, para cada cor c presente
+// na vizinhança, min(k, d + 1), onde k é o número de vizinhos de v com a
+// cor c: cada vizinho com a cor consome uma unidade da folga de v nela, e a
+// cor pesa d + 1 (como no DSATUR clássico com d = 0) quando v já não pode
+// recebê-la. A saturação só cresce e nunca passa do grau, de modo que os
+// vértices ficam em baldes por saturação; cada balde é um heap por
+// (grau, vértice) para o desempate, e uma árvore de Fenwick sobre os
+// tamanhos dos baldes dá extremos, contagem da RCL e k-ésimo em O(log n).
+//
+// A interface é a de FilaCandidatos (mesma RCL no GRASP); kesimo(0) é o
+// vértice mais saturado e, no empate, o de maior grau. As contagens k de
+// cada par (vértice, cor) ficam numa tabela hash de endereçamento aberto,
+// dimensionada pelos pares de fato inseridos (no máximo um por aresta) e
+// mantida entre construções; reiniciar() limpa só as posições usadas.
+// Custo total de uma construção: O((n + m) log n).
+class FilaSaturacao {
+private:
+    const Grafo& grafo;
+    int d;
+    int n;
+    int grauMaximo;             // saturações possíveis: 0..grauMaximo
+    int restantes;
+    int passoInicial;           // maior potência de 2 <= grauMaximo + 1
+
+    vector<int> grau;           // grau de cada vértice (desempate)
+
+    vector<int> ordemInicial;   // vértices por (grau, vértice) decrescente
+    vector<vector<int>> baldes; // baldes[s] = heap dos restantes com saturação s
+    vector<int> saturacao;      // saturação de cada vértice
+    vector<int> posicao;        // índice de v no heap do seu balde (-1 se removido)
+    vector<int> arvore;         // Fenwick (1-indexada) sobre p = grauMaximo - s + 1
+
+    // Tabela hash (vértice, cor) -> vizinhos do vértice com a cor
+    vector<uint64_t> chavesTabela;
+    vector<int> contagemTabela;
+    vector<uint64_t> ocupadas;  // posições usadas desde o último reiniciar()
+    uint64_t mascaraTabela;
+    int deslocamentoTabela;     // 64 - log2(capacidade): bits altos do produto
+
+    bool antes(int a, int b) const;   // a tem prioridade sobre b no heap
+    void subir(vector<int>& heap, int i);
+    void descer(vector<int>& heap, int i);
+    void inserirNoBalde(int v, int s);
+    void retirarDoBalde(int v);
+    void somarArvore(int s, int delta);
+
+    // Balde e deslocamento no heap do k-ésimo restante (ordem decrescente)
+    void localizar(int k, int& s, int& deslocamento) const;
+
+    // Posição da chave na tabela, ou a posição vazia onde ela entraria
+    uint64_t posicaoNaTabela(uint64_t chave) const;
+
+    // Dobra a tabela, reinserindo os pares ocupados
+    void ampliarTabela();
+
+    // Incrementa a contagem de (v, cor) e devolve o novo valor
+    int incrementarContagem(int v, int cor);
+
+public:
+    FilaSaturacao(const Grafo& g, int deficiencia);
+
+    // Todos os vértices restantes, com saturação zero
+    void reiniciar();
+
+    bool vazia() const { return restantes == 0; }
+    int tamanho() const { return restantes; }
+
+    // Maior e menor saturação entre os restantes
+    int chaveMaxima() const;
+    int chaveMinima() const;
+
+    // Número de restantes com saturação >= limiar (o tamanho da RCL)
+    int contarAcima(double limiar) const;
+
+    // k-ésimo restante na ordem decrescente de saturação, k a partir de 0
+    int kesimo(int k) const;
+
+    // Remove o vértice v dos restantes
+    void remover(int v);
+
+    // Atualiza a saturação dos vizinhos restantes de u, que recebeu a cor
+    void registrarCor(int u, int cor);
+};
+
+#endif
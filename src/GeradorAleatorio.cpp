@@ -0,0 +1,22 @@
+#include "GeradorAleatorio.h"
+
+// splitmix64: avança x e devolve o valor misturado
+static uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Construtor
+GeradorAleatorio::GeradorAleatorio(uint64_t semente, uint64_t fluxo) {
+    semear(semente, fluxo);
+}
+
+// O fluxo f começa no valor 4f da sequência splitmix64 da semente
+void GeradorAleatorio::semear(uint64_t semente, uint64_t fluxo) {
+    uint64_t x = semente + fluxo * 4 * 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < 4; i++) {
+        estado[i] = splitmix64(x);
+    }
+}
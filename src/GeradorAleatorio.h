@@ -0,0 +1,74 @@
+#ifndef GERADOR_ALEATORIO_H
+#define GERADOR_ALEATORIO_H
+
+#include <cstdint>
+
+using namespace std;
+
+// Gerador pseudoaleatório xoshiro256** (Blackman e Vigna), com estado
+// inicializado por splitmix64. Toda a aleatoriedade dos algoritmos passa
+// por ele: a sequência depende só da semente, e não da biblioteca C nem da
+// plataforma (ao contrário de rand() e das distribuições de <random>).
+//
+// Fluxos independentes são derivados da semente por um contador: o fluxo f
+// é inicializado com os valores 4f .. 4f + 3 da sequência splitmix64 que
+// parte da semente, logo dois fluxos nunca compartilham o estado inicial e
+// cada um é obtido em O(1), sem percorrer os anteriores. Assim cada
+// iteração do GRASP usa o fluxo da própria iteração, e a mesma semente
+// produz a mesma coloração com qualquer número de threads.
+class GeradorAleatorio {
+private:
+    uint64_t estado[4];
+
+    static uint64_t rotacionar(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    typedef uint64_t result_type;
+
+    GeradorAleatorio(uint64_t semente = 0, uint64_t fluxo = 0);
+
+    // Reinicia no fluxo informado da semente
+    void semear(uint64_t semente, uint64_t fluxo = 0);
+
+    // Próximos 64 bits (no caminho crítico: inline)
+    uint64_t proximo() {
+        uint64_t resultado = rotacionar(estado[1] * 5, 7) * 9;
+        uint64_t t = estado[1] << 17;
+        estado[2] ^= estado[0];
+        estado[3] ^= estado[1];
+        estado[1] ^= estado[2];
+        estado[0] ^= estado[3];
+        estado[2] ^= t;
+        estado[3] = rotacionar(estado[3], 45);
+        return resultado;
+    }
+
+    // Inteiro uniforme em [0, limite), sem o viés do módulo (método de
+    // Lemire: uma multiplicação, e divisão só no raro caso de rejeição)
+    uint32_t limitado(uint32_t limite) {
+        uint64_t produto = (uint64_t)(uint32_t)(proximo() >> 32) * limite;
+        uint32_t resto = (uint32_t)produto;
+        if (resto < limite) {
+            uint32_t minimo = (0u - limite) % limite;
+            while (resto < minimo) {
+                produto = (uint64_t)(uint32_t)(proximo() >> 32) * limite;
+                resto = (uint32_t)produto;
+            }
+        }
+        return (uint32_t)(produto >> 32);
+    }
+
+    // Real uniforme em [0, 1) com 53 bits
+    double uniforme() {
+        return (proximo() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Interface de UniformRandomBitGenerator
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return UINT64_MAX; }
+    uint64_t operator()() { return proximo(); }
+};
+
+#endif
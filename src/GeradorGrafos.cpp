@@ -0,0 +1,164 @@
+#include "GeradorGrafos.h"
+#include "GeradorAleatorio.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+// Monta o grafo a partir de pares (u, v), descartando laços e repetições
+static Grafo* montarGrafo(int n, vector<pair<int, int>>& arestas) {
+    for (auto& a : arestas) {
+        if (a.first > a.second) {
+            swap(a.first, a.second);
+        }
+    }
+    sort(arestas.begin(), arestas.end());
+    arestas.erase(unique(arestas.begin(), arestas.end()), arestas.end());
+
+    Grafo* g = new Grafo(n);
+    for (auto& a : arestas) {
+        if (a.first != a.second) {
+            g->adicionarAresta(a.first, a.second);
+        }
+    }
+    g->congelar();
+    return g;
+}
+
+// Erdős–Rényi por saltos geométricos sobre os pares (u < v)
+Grafo* GeradorGrafos::erdosRenyi(int n, long long m, unsigned int semente) {
+    GeradorAleatorio gerador(semente);
+    vector<pair<int, int>> arestas;
+    double totalPares = (double)n * (n - 1) / 2.0;
+    double p = (totalPares > 0) ? min(1.0, m / totalPares) : 0.0;
+
+    if (p > 0) {
+        arestas.reserve((size_t)(p * totalPares * 1.05) + 16);
+        double logQ = log(1.0 - min(p, 1.0 - 1e-12));
+        long long v = 1, w = -1;
+        while (v < n) {
+            w += 1 + (long long)floor(log(1.0 - gerador.uniforme()) / logQ);
+            while (w >= v && v < n) {
+                w -= v;
+                v++;
+            }
+            if (v < n) {
+                arestas.push_back({(int)w, (int)v});
+            }
+        }
+    }
+    return montarGrafo(n, arestas);
+}
+
+// Geométrico aleatório com grade de células de lado r
+Grafo* GeradorGrafos::geometrico(int n, long long m, unsigned int semente) {
+    GeradorAleatorio gerador(semente);
+    vector<double> x(n), y(n);
+    for (int i = 0; i < n; i++) {
+        x[i] = gerador.uniforme();
+        y[i] = gerador.uniforme();
+    }
+
+    // E[m] ~ n(n-1)/2 * pi * r^2 (desconsiderando a borda); M_PI não é padrão
+    const double PI = acos(-1.0);
+    double r = (n > 1) ? sqrt(2.0 * m / ((double)n * (n - 1) * PI)) : 1.0;
+    r = min(max(r, 1e-9), 1.0);
+    int celulas = max(1, min((int)(1.0 / r), 4096));
+
+    vector<vector<int>> grade((size_t)celulas * celulas);
+    for (int i = 0; i < n; i++) {
+        int cx = min((int)(x[i] * celulas), celulas - 1);
+        int cy = min((int)(y[i] * celulas), celulas - 1);
+        grade[(size_t)cx * celulas + cy].push_back(i);
+    }
+
+    vector<pair<int, int>> arestas;
+    double r2 = r * r;
+    for (int cx = 0; cx < celulas; cx++) {
+        for (int cy = 0; cy < celulas; cy++) {
+            for (int i : grade[(size_t)cx * celulas + cy]) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    for (int dy = -1; dy <= 1; dy++) {
+                        int nx = cx + dx, ny = cy + dy;
+                        if (nx < 0 || ny < 0 || nx >= celulas || ny >= celulas) {
+                            continue;
+                        }
+                        for (int j : grade[(size_t)nx * celulas + ny]) {
+                            double ddx = x[i] - x[j], ddy = y[i] - y[j];
+                            if (i < j && ddx * ddx + ddy * ddy <= r2) {
+                                arestas.push_back({i, j});
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return montarGrafo(n, arestas);
+}
+
+// Chung–Lu: extremos sorteados com probabilidade proporcional a w_i = (i + 1)^(-1/(gama - 1))
+Grafo* GeradorGrafos::leiPotencia(int n, long long m, unsigned int semente) {
+    GeradorAleatorio gerador(semente);
+    const double gama = 2.5;
+
+    vector<double> acumulado(n);
+    double soma = 0.0;
+    for (int i = 0; i < n; i++) {
+        soma += pow(i + 1.0, -1.0 / (gama - 1.0));
+        acumulado[i] = soma;
+    }
+
+    vector<pair<int, int>> arestas;
+    arestas.reserve(m);
+    for (long long e = 0; e < m && n > 1; e++) {
+        int u = lower_bound(acumulado.begin(), acumulado.end(), gerador.uniforme() * soma) - acumulado.begin();
+        int v = lower_bound(acumulado.begin(), acumulado.end(), gerador.uniforme() * soma) - acumulado.begin();
+        arestas.push_back({min(u, n - 1), min(v, n - 1)});
+    }
+
+    // Embaralha os rótulos para que o grau não siga a numeração
+    vector<int> rotulo(n);
+    for (int i = 0; i < n; i++) {
+        rotulo[i] = i;
+    }
+    for (int i = n - 1; i > 0; i--) {
+        swap(rotulo[i], rotulo[gerador.limitado(i + 1)]);
+    }
+    for (auto& a : arestas) {
+        a.first = rotulo[a.first];
+        a.second = rotulo[a.second];
+    }
+    return montarGrafo(n, arestas);
+}
+
+// k-partido: vértice i pertence à parte i % k
+Grafo* GeradorGrafos::kPartido(int n, long long m, int k, unsigned int semente) {
+    GeradorAleatorio gerador(semente);
+    vector<pair<int, int>> arestas;
+    arestas.reserve(m);
+
+    // Sorteia pares até obter m arestas entre partes diferentes
+    for (long long tentativa = 0; (long long)arestas.size() < m && tentativa < 4 * m &&
+                                  n > 1 && k > 1; tentativa++) {
+        int u = gerador.limitado(n);
+        int v = gerador.limitado(n);
+        if (u % k != v % k) {
+            arestas.push_back({u, v});
+        }
+    }
+    return montarGrafo(n, arestas);
+}
+
+// Gera pelo nome
+Grafo* GeradorGrafos::gerar(const string& tipo, int n, long long m, unsigned int semente) {
+    if (tipo == "er") {
+        return erdosRenyi(n, m, semente);
+    } else if (tipo == "rgg") {
+        return geometrico(n, m, semente);
+    } else if (tipo == "powerlaw") {
+        return leiPotencia(n, m, semente);
+    } else if (tipo == "kpartite") {
+        return kPartido(n, m, 4, semente);
+    }
+    return nullptr;
+}
@@ -0,0 +1,31 @@
+#ifndef GERADOR_GRAFOS_H
+#define GERADOR_GRAFOS_H
+
+#include "Grafo.h"
+#include <string>
+
+using namespace std;
+
+// Geradores de grafos sintéticos para os benchmarks.
+// Todos produzem grafos simples (sem laços nem arestas repetidas), já
+// congelados, com aproximadamente m arestas e reprodutíveis pela semente
+// (GeradorAleatorio: os mesmos grafos em qualquer plataforma).
+class GeradorGrafos {
+public:
+    // Erdős–Rényi G(n, p) com p = m / (n(n-1)/2), gerado por saltos geométricos em O(n + m)
+    static Grafo* erdosRenyi(int n, long long m, unsigned int semente);
+
+    // Geométrico aleatório no quadrado unitário, raio escolhido para ~m arestas
+    static Grafo* geometrico(int n, long long m, unsigned int semente);
+
+    // Lei de potência (modelo de Chung–Lu, expoente 2.5)
+    static Grafo* leiPotencia(int n, long long m, unsigned int semente);
+
+    // k-partido: arestas sorteadas apenas entre partes diferentes
+    static Grafo* kPartido(int n, long long m, int k, unsigned int semente);
+
+    // Gera pelo nome: "er", "rgg", "powerlaw" ou "kpartite" (k = 4); nullptr se desconhecido
+    static Grafo* gerar(const string& tipo, int n, long long m, unsigned int semente);
+};
+
+#endif
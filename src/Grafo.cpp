@@ -1,16 +1,60 @@
 #include "Grafo.h"
+#include "LeitorInstancia.h"
+#include "ArquivoMapeado.h"
+#include "CacheGrafo.h"
+#include "EscritorAssincrono.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
-#include <set>
+
+const double Grafo::DENSIDADE_MATRIZ_BITS = 0.1;
 
 // Construtor
 Grafo::Grafo(int n) {
     numVertices = n;
     numArestas = 0;
+    congelado = false;
+    csrInicio = nullptr;
+    csrVizinhos = nullptr;
+    mapeamento = nullptr;
+    palavrasPorLinha = 0;
     adj.resize(n);
 }
 
+// Construtor a partir do formato CSR
+Grafo::Grafo(int n, long long m, vector<long long>& inicio, vector<int>& adjacentes) {
+    numVertices = n;
+    numArestas = m;
+    congelado = true;
+    inicioVizinhos.swap(inicio);
+    vizinhos.swap(adjacentes);
+    csrInicio = inicioVizinhos.data();
+    csrVizinhos = vizinhos.data();
+    mapeamento = nullptr;
+    palavrasPorLinha = 0;
+    escolherBackend();
+}
+
+// Construtor sobre um CSR mapeado em memória
+Grafo::Grafo(int n, long long m, ArquivoMapeado* mapa, const long long* inicio, const int* adjacentes,
+             bool permitirMatrizBits) {
+    numVertices = n;
+    numArestas = m;
+    congelado = true;
+    csrInicio = inicio;
+    csrVizinhos = adjacentes;
+    mapeamento = mapa;
+    palavrasPorLinha = 0;
+    if (permitirMatrizBits) {
+        escolherBackend();
+    }
+}
+
+// Destrutor
+Grafo::~Grafo() {
+    delete mapeamento;
+}
+
 // Adiciona aresta u - v
 void Grafo::adicionarAresta(int u, int v) {
     if (u < 0 || v < 0 || u >= numVertices || v >= numVertices) {
@@ -18,14 +62,150 @@ void Grafo::adicionarAresta(int u, int v) {
         return;
     }
 
+    if (congelado) {
+        descongelar();
+    }
+
     adj[u].push_back(v);
     adj[v].push_back(u);
     numArestas++;
 }
 
-// Retorna lista de adjacência
-const vector<int>& Grafo::getAdjacentes(int v) const {
-    return adj[v];
+// Converte as listas de adjacência para CSR
+void Grafo::congelar() {
+    if (congelado) {
+        return;
+    }
+
+    inicioVizinhos.assign(numVertices + 1, 0);
+    for (int v = 0; v < numVertices; v++) {
+        inicioVizinhos[v + 1] = inicioVizinhos[v] + adj[v].size();
+    }
+
+    vizinhos.resize(inicioVizinhos[numVertices]);
+    for (int v = 0; v < numVertices; v++) {
+        copy(adj[v].begin(), adj[v].end(), vizinhos.begin() + inicioVizinhos[v]);
+    }
+    long long lacos, repetidas;
+    numArestas = normalizarCSR(numVertices, inicioVizinhos, vizinhos, lacos, repetidas);
+
+    // Libera as listas (uma alocação por vértice)
+    vector<vector<int>>().swap(adj);
+    csrInicio = inicioVizinhos.data();
+    csrVizinhos = vizinhos.data();
+    congelado = true;
+    escolherBackend();
+}
+
+// Normaliza as linhas do CSR (ordenadas, sem laços nem repetições)
+long long Grafo::normalizarCSR(int n, vector<long long>& inicio, vector<int>& vizinhos,
+                               long long& lacos, long long& repetidas) {
+    long long distintas = normalizarCSR(n, inicio.data(), vizinhos.data(), lacos, repetidas);
+
+    if (inicio[n] < (long long)vizinhos.size()) {
+        vizinhos.resize(inicio[n]);
+        vizinhos.shrink_to_fit();
+    }
+    return distintas;
+}
+
+// Normalização sobre vetores crus (ex.: um CSR mapeado de um arquivo)
+long long Grafo::normalizarCSR(int n, long long* inicio, int* vizinhos,
+                               long long& lacos, long long& repetidas) {
+    long long escrita = 0;
+    long long entradasLaco = 0, entradasRepetidas = 0;
+
+    for (int v = 0; v < n; v++) {
+        // inicio[v] é reescrito, mas inicio[v + 1] só é lido na próxima linha
+        long long a = inicio[v], b = inicio[v + 1];
+        sort(vizinhos + a, vizinhos + b);
+        inicio[v] = escrita;
+
+        for (long long i = a; i < b; i++) {
+            int u = vizinhos[i];
+            if (u == v) {
+                entradasLaco++;
+            } else if (escrita > inicio[v] && vizinhos[escrita - 1] == u) {
+                entradasRepetidas++;
+            } else {
+                vizinhos[escrita++] = u;
+            }
+        }
+    }
+    inicio[n] = escrita;
+
+    // Cada laço ocupa duas entradas da própria linha; cada repetição, uma em cada ponta
+    lacos = entradasLaco / 2;
+    repetidas = entradasRepetidas / 2;
+    return escrita / 2;
+}
+
+// Reconstrói as listas de adjacência a partir do CSR
+void Grafo::descongelar() {
+    adj.assign(numVertices, vector<int>());
+    for (int v = 0; v < numVertices; v++) {
+        adj[v].assign(csrVizinhos + csrInicio[v], csrVizinhos + csrInicio[v + 1]);
+    }
+
+    vector<long long>().swap(inicioVizinhos);
+    vector<int>().swap(vizinhos);
+    delete mapeamento;
+    mapeamento = nullptr;
+    csrInicio = nullptr;
+    csrVizinhos = nullptr;
+    congelado = false;
+    usarMatrizBits(false);
+}
+
+// Densidade do grafo
+double Grafo::getDensidade() const {
+    if (numVertices < 2) {
+        return 0.0;
+    }
+    return 2.0 * numArestas / ((double)numVertices * (numVertices - 1));
+}
+
+// Backend denso automático para grafos com densidade suficiente
+void Grafo::escolherBackend() {
+    if (getDensidade() >= DENSIDADE_MATRIZ_BITS) {
+        usarMatrizBits(true);
+    }
+}
+
+// Constrói ou libera a matriz de adjacência em bits
+bool Grafo::usarMatrizBits(bool ativar) {
+    vector<uint64_t>().swap(matrizBits);
+    palavrasPorLinha = 0;
+    if (!ativar || !congelado || numVertices == 0) {
+        return false;
+    }
+
+    int palavras = (numVertices + 63) / 64;
+    matrizBits.assign((size_t)numVertices * palavras, 0);
+    for (int v = 0; v < numVertices; v++) {
+        uint64_t* linha = matrizBits.data() + (size_t)v * palavras;
+        // As linhas do CSR não têm laços nem repetições: um bit por vizinho
+        for (int u : getAdjacentes(v)) {
+            linha[u >> 6] |= 1ULL << (u & 63);
+        }
+    }
+    palavrasPorLinha = palavras;
+    return true;
+}
+
+// Indica se o grafo está no formato CSR
+bool Grafo::estaCongelado() const {
+    return congelado;
+}
+
+// Deslocamentos do CSR
+const long long* Grafo::getInicioVizinhos() const {
+    return csrInicio;
+}
+
+// Vizinhos do CSR
+const int* Grafo::getVizinhos() const {
+    return csrVizinhos;
 }
 
 // Retorna o número de vértices
@@ -34,7 +214,7 @@ int Grafo::getNumVertices() const {
 }
 
 // Retorna o número de arestas
-int Grafo::getNumArestas() const {
+long long Grafo::getNumArestas() const {
     return numArestas;
 }
 
@@ -43,7 +223,255 @@ int Grafo::getGrau(int v) const {
     if (v < 0 || v >= numVertices) {
         return -1;
     }
-    return adj[v].size();
+    return getAdjacentes(v).size();
+}
+
+// Busca binária sem desvios em um intervalo ordenado: o laço só decide,
+// por movimentação condicional, de que lado continua
+static inline bool buscaOrdenada(const int* base, size_t tamanho, int alvo) {
+    if (tamanho == 0) {
+        return false;
+    }
+    const int* fim = base + tamanho;
+    while (tamanho > 1) {
+        size_t metade = tamanho / 2;
+        base = (base[metade] < alvo) ? base + metade : base;
+        tamanho -= metade;
+    }
+    base += (*base < alvo);
+    return base < fim && *base == alvo;
+}
+
+// Ordem smallest-last com listas encadeadas por grau restante
+vector<int> Grafo::ordemSmallestLast(int* degeneracao) const {
+    int n = numVertices;
+    vector<int> grau(n);
+    int grauMaximo = 0;
+    for (int v = 0; v < n; v++) {
+        grau[v] = getGrau(v);
+        grauMaximo = max(grauMaximo, grau[v]);
+    }
+
+    // cabeca[g] = primeiro vértice restante com grau g (-1 se nenhum)
+    vector<int> cabeca(grauMaximo + 1, -1), proximo(n), anterior(n);
+    auto inserir = [&](int v) {
+        anterior[v] = -1;
+        proximo[v] = cabeca[grau[v]];
+        if (proximo[v] >= 0) {
+            anterior[proximo[v]] = v;
+        }
+        cabeca[grau[v]] = v;
+    };
+    auto retirar = [&](int v) {
+        if (anterior[v] >= 0) {
+            proximo[anterior[v]] = proximo[v];
+        } else {
+            cabeca[grau[v]] = proximo[v];
+        }
+        if (proximo[v] >= 0) {
+            anterior[proximo[v]] = anterior[v];
+        }
+    };
+    for (int v = 0; v < n; v++) {
+        inserir(v);
+    }
+
+    // Retira o vértice de menor grau restante; cada retirada baixa o grau
+    // dos vizinhos em 1, logo o mínimo recua no máximo uma posição
+    vector<char> retirado(n, 0);
+    vector<int> ordem(n);
+    int menor = 0, maiorRetirada = 0;
+    for (int i = n - 1; i >= 0; i--) {
+        while (cabeca[menor] < 0) {
+            menor++;
+        }
+        int v = cabeca[menor];
+        retirar(v);
+        retirado[v] = 1;
+        ordem[i] = v;
+        maiorRetirada = max(maiorRetirada, menor);
+
+        for (int u : getAdjacentes(v)) {
+            if (!retirado[u]) {
+                retirar(u);
+                grau[u]--;
+                inserir(u);
+            }
+        }
+        menor = max(menor - 1, 0);
+    }
+
+    if (degeneracao != nullptr) {
+        *degeneracao = maiorRetirada;
+    }
+    return ordem;
+}
+
+// Reordenação pelo nome usado na linha de comando
+bool Grafo::lerReordenacao(const string& nome, Reordenacao& r) {
+    if (nome == "nenhuma") {
+        r = REORDENACAO_NENHUMA;
+    } else if (nome == "rcm") {
+        r = REORDENACAO_RCM;
+    } else if (nome == "bfs") {
+        r = REORDENACAO_BFS;
+    } else if (nome == "grau") {
+        r = REORDENACAO_GRAU;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+string Grafo::nomeReordenacao(Reordenacao r) {
+    switch (r) {
+        case REORDENACAO_RCM:
+            return "rcm";
+        case REORDENACAO_BFS:
+            return "bfs";
+        case REORDENACAO_GRAU:
+            return "grau";
+        default:
+            return "nenhuma";
+    }
+}
+
+// Busca em largura a partir de raiz sobre os vértices ainda não visitados,
+// acrescentando-os a ordem. Com porGrau, os vizinhos de cada vértice entram
+// em ordem crescente de grau (Cuthill-McKee); senão, na ordem do CSR.
+void Grafo::buscaLargura(int raiz, bool porGrau, vector<char>& visitado, vector<int>& ordem) const {
+    size_t cabeca = ordem.size();
+    ordem.push_back(raiz);
+    visitado[raiz] = 1;
+    while (cabeca < ordem.size()) {
+        int v = ordem[cabeca++];
+        size_t primeiro = ordem.size();
+        for (int u : getAdjacentes(v)) {
+            if (!visitado[u]) {
+                visitado[u] = 1;
+                ordem.push_back(u);
+            }
+        }
+        if (porGrau) {
+            sort(ordem.begin() + primeiro, ordem.end(), [this](int a, int b) {
+                int ga = getGrau(a), gb = getGrau(b);
+                return ga < gb || (ga == gb && a < b);
+            });
+        }
+    }
+}
+
+// Vértice pseudo-periférico (George e Liu): a partir da raiz, repete a BFS
+// pelo vértice de menor grau do último nível enquanto a excentricidade crescer
+int Grafo::verticePeriferico(int raiz, vector<int>& nivel, vector<int>& fila) const {
+    int excentricidade = -1;
+    for (int tentativa = 0; tentativa < 8; tentativa++) {
+        // BFS com níveis; os visitados são desfeitos ao final pela própria fila
+        fila.clear();
+        fila.push_back(raiz);
+        nivel[raiz] = 0;
+        for (size_t i = 0; i < fila.size(); i++) {
+            int v = fila[i];
+            for (int u : getAdjacentes(v)) {
+                if (nivel[u] < 0) {
+                    nivel[u] = nivel[v] + 1;
+                    fila.push_back(u);
+                }
+            }
+        }
+        int ultimoNivel = nivel[fila.back()];
+        int candidato = fila.back();
+        for (size_t i = fila.size(); i-- > 0 && nivel[fila[i]] == ultimoNivel;) {
+            if (getGrau(fila[i]) < getGrau(candidato)) {
+                candidato = fila[i];
+            }
+        }
+        for (int v : fila) {
+            nivel[v] = -1;
+        }
+        if (ultimoNivel <= excentricidade) {
+            break;
+        }
+        excentricidade = ultimoNivel;
+        raiz = candidato;
+    }
+    return raiz;
+}
+
+// Ordem dos vértices após a reordenação: ordem[i] = vértice que passa a ser i
+vector<int> Grafo::ordemReordenacao(Reordenacao r) const {
+    int n = numVertices;
+    vector<int> ordem;
+    ordem.reserve(n);
+
+    if (r == REORDENACAO_GRAU) {
+        // Grau decrescente (a ordem do Guloso), desempate pelo identificador
+        for (int v = 0; v < n; v++) {
+            ordem.push_back(v);
+        }
+        stable_sort(ordem.begin(), ordem.end(),
+                    [this](int a, int b) { return getGrau(a) > getGrau(b); });
+        return ordem;
+    }
+
+    if (r == REORDENACAO_NENHUMA) {
+        for (int v = 0; v < n; v++) {
+            ordem.push_back(v);
+        }
+        return ordem;
+    }
+
+    vector<char> visitado(n, 0);
+    if (r == REORDENACAO_BFS) {
+        // Uma BFS por componente, a partir do menor identificador não visitado
+        for (int v = 0; v < n; v++) {
+            if (!visitado[v]) {
+                buscaLargura(v, false, visitado, ordem);
+            }
+        }
+        return ordem;
+    }
+
+    // RCM: componentes a partir do vértice de menor grau, cada uma iniciada
+    // num vértice pseudo-periférico; a ordem de Cuthill-McKee é invertida
+    vector<int> porGrau(n);
+    for (int v = 0; v < n; v++) {
+        porGrau[v] = v;
+    }
+    stable_sort(porGrau.begin(), porGrau.end(),
+                [this](int a, int b) { return getGrau(a) < getGrau(b); });
+    vector<int> nivel(n, -1), fila;
+    for (int v : porGrau) {
+        if (!visitado[v]) {
+            buscaLargura(verticePeriferico(v, nivel, fila), true, visitado, ordem);
+        }
+    }
+    reverse(ordem.begin(), ordem.end());
+    return ordem;
+}
+
+// Grafo com os vértices renumerados: o vértice ordem[i] passa a ser i
+Grafo* Grafo::reordenar(const vector<int>& ordem) const {
+    int n = numVertices;
+    vector<int> posicao(n);
+    for (int i = 0; i < n; i++) {
+        posicao[ordem[i]] = i;
+    }
+
+    vector<long long> inicio(n + 1, 0);
+    for (int i = 0; i < n; i++) {
+        inicio[i + 1] = inicio[i] + getGrau(ordem[i]);
+    }
+    vector<int> adjacentes(inicio[n]);
+    for (int i = 0; i < n; i++) {
+        int* linha = adjacentes.data() + inicio[i];
+        int k = 0;
+        for (int u : getAdjacentes(ordem[i])) {
+            linha[k++] = posicao[u];
+        }
+        sort(linha, linha + k);
+    }
+    return new Grafo(n, numArestas, inicio, adjacentes);
 }
 
 // Verifica se existe aresta entre u e v
@@ -52,7 +480,20 @@ bool Grafo::existeAresta(int u, int v) const {
         return false;
     }
     
-    for (int vizinho : adj[u]) {
+    if (palavrasPorLinha > 0) {
+        return (getLinhaBits(u)[v >> 6] >> (v & 63)) & 1;
+    }
+    
+    if (congelado) {
+        // Busca na menor das duas linhas
+        Vizinhanca nu = getAdjacentes(u), nv = getAdjacentes(v);
+        if (nv.size() < nu.size()) {
+            return buscaOrdenada(nv.begin(), nv.size(), u);
+        }
+        return buscaOrdenada(nu.begin(), nu.size(), v);
+    }
+    
+    for (int vizinho : getAdjacentes(u)) {
         if (vizinho == v) {
             return true;
         }
@@ -64,7 +505,7 @@ bool Grafo::existeAresta(int u, int v) const {
 void Grafo::imprimir() const {
     for (int i = 0; i < numVertices; i++) {
         cout << i << ": ";
-        for (int v : adj[i]) {
+        for (int v : getAdjacentes(i)) {
             cout << v << " ";
         }
         cout << endl;
@@ -76,50 +517,71 @@ void Grafo::imprimir() const {
 // Linha 1: número de vértices
 // Linha 2: número de arestas
 // Linhas seguintes: pares de vértices (u v) representando arestas
-Grafo* Grafo::lerArquivo(const string& nomeArquivo) {
-    ifstream arquivo(nomeArquivo);
+Grafo* Grafo::lerArquivo(const string& nomeArquivo, bool usarCache) {
+    RelatorioLeitura relatorio;
+    Grafo* g = lerArquivo(nomeArquivo, relatorio, usarCache);
     
-    if (!arquivo.is_open()) {
-        cerr << "Erro ao abrir arquivo: " << nomeArquivo << endl;
-        return nullptr;
+    if (relatorio.temProblemas()) {
+        relatorio.imprimir(cerr, nomeArquivo);
+    }
+    return g;
+}
+
+// Leitura com relatório estruturado dos problemas de formato
+Grafo* Grafo::lerArquivo(const string& nomeArquivo, RelatorioLeitura& relatorio, bool usarCache) {
+    if (usarCache) {
+        Grafo* g = CacheGrafo::carregar(nomeArquivo, relatorio);
+        if (g != nullptr) {
+            return g;
+        }
     }
     
-    int n, m;
-    arquivo >> n >> m;
-    
-    Grafo* g = new Grafo(n);
+    Grafo* g = LeitorInstancia::ler(nomeArquivo, relatorio);
     
-    for (int i = 0; i < m; i++) {
-        int u, v;
-        arquivo >> u >> v;
-        g->adicionarAresta(u, v);
+    if (g != nullptr && usarCache) {
+        CacheGrafo::salvar(*g, nomeArquivo, relatorio.totalProblemas);
     }
-    
-    arquivo.close();
     return g;
 }
 
+// Cada aresta uma vez, como "u v" com u < v: a linha inteira é percorrida,
+// pois fora do CSR (após adicionarAresta) as listas não são ordenadas
+void Grafo::escreverArestas(EscritorAssincrono& saida, const vector<int>* rotulos) const {
+    for (int u = 0; u < numVertices; u++) {
+        for (int v : getAdjacentes(u)) {
+            if (v <= u) {
+                continue;
+            }
+            int a = u, b = v;
+            if (rotulos != nullptr) {
+                a = (*rotulos)[u];
+                b = (*rotulos)[v];
+                if (a > b) {
+                    swap(a, b);
+                }
+            }
+            saida.escreverInteiro(a);
+            saida.escreverCaractere(' ');
+            saida.escreverInteiro(b);
+            saida.escreverCaractere('\n');
+        }
+    }
+}
+
 // Exporta para formato GraphEditor (csacademy.com/app/grapheditor/)
 void Grafo::exportarGraphEditor(const string& nomeArquivo) const {
-    ofstream arquivo(nomeArquivo);
+    EscritorAssincrono arquivo;
     
-    if (!arquivo.is_open()) {
+    if (!arquivo.abrir(nomeArquivo)) {
         cerr << "Erro ao criar arquivo: " << nomeArquivo << endl;
         return;
     }
     
-    // Evita duplicatas (grafo não direcionado)
-    set<pair<int, int>> arestasProcessadas;
+    escreverArestas(arquivo);
     
-    for (int u = 0; u < numVertices; u++) {
-        for (int v : adj[u]) {
-            if (arestasProcessadas.find({min(u, v), max(u, v)}) == arestasProcessadas.end()) {
-                arquivo << u << " " << v << endl;
-                arestasProcessadas.insert({min(u, v), max(u, v)});
-            }
-        }
+    if (!arquivo.fechar()) {
+        cerr << "Erro ao gravar arquivo: " << nomeArquivo << endl;
+        return;
     }
-    
-    arquivo.close();
     cout << "Grafo exportado para " << nomeArquivo << endl;
 }
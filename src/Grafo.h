@@ -2,47 +2,190 @@
 #define GRAFO_H
 
 #include <vector>
+#include <cstdint>
 #include <iostream>
 #include <string>
 
 using namespace std;
 
+struct RelatorioLeitura;
+class ArquivoMapeado;
+class EscritorAssincrono;
+
+// Vizinhança de um vértice: intervalo contíguo [inicio, fim) de vértices
+class Vizinhanca {
+private:
+    const int* inicio;
+    const int* fim;
+
+public:
+    Vizinhanca(const int* i, const int* f) : inicio(i), fim(f) {}
+
+    const int* begin() const { return inicio; }
+    const int* end() const { return fim; }
+    size_t size() const { return fim - inicio; }
+    int operator[](size_t i) const { return inicio[i]; }
+};
+
+// Renumeração dos vértices para localidade de memória (--reordenar)
+enum Reordenacao {
+    REORDENACAO_NENHUMA,
+    REORDENACAO_RCM,    // Cuthill-McKee reverso: vizinhos com identificadores próximos
+    REORDENACAO_BFS,    // ordem de uma busca em largura por componente
+    REORDENACAO_GRAU    // grau decrescente (a ordem em que o Guloso visita os vértices)
+};
+
+// Grafo não direcionado.
+// Durante a construção usa listas de adjacência (uma por vértice); congelar()
+// converte para o formato CSR (compressed sparse row): um vetor contíguo de
+// vizinhos e um vetor de deslocamentos, em que os vizinhos de v ocupam
+// vizinhos[inicioVizinhos[v] .. inicioVizinhos[v + 1]). As consultas usam o
+// formato vigente de forma transparente. O CSR pode pertencer ao grafo ou
+// residir em um cache binário mapeado em memória (sem cópia).
+// No CSR cada linha está ordenada e sem repetições nem laços, o que permite
+// responder existeAresta por busca binária em O(log grau).
+// Grafos congelados com densidade a partir de DENSIDADE_MATRIZ_BITS
+// ganham também uma matriz de adjacência em bits (backend denso), usada
+// pela coloração para contar vizinhos por cor com AND + popcount.
 class Grafo {
 private:
     int numVertices;
-    int numArestas;
-    vector<vector<int>> adj; // lista de adjacência
+    long long numArestas;
+    vector<vector<int>> adj; // lista de adjacência (modo de construção)
+
+    // Formato CSR (modo congelado)
+    bool congelado;
+    vector<long long> inicioVizinhos; // n + 1 deslocamentos
+    vector<int> vizinhos;             // 2m vizinhos contíguos
+    const long long* csrInicio;       // aponta para inicioVizinhos ou para o mapeamento
+    const int* csrVizinhos;           // aponta para vizinhos ou para o mapeamento
+    ArquivoMapeado* mapeamento;       // cache binário mapeado (nullptr se próprio)
+
+    // Backend denso: linha v = bits dos vizinhos de v
+    vector<uint64_t> matrizBits;
+    int palavrasPorLinha;             // 0 se a matriz não existe
+
+    // Constrói a matriz de bits se o grafo atingir a densidade mínima
+    void escolherBackend();
+
+    // Reconstrói as listas de adjacência a partir do CSR
+    void descongelar();
+
+    // Auxiliares das reordenações BFS e RCM
+    void buscaLargura(int raiz, bool porGrau, vector<char>& visitado, vector<int>& ordem) const;
+    int verticePeriferico(int raiz, vector<int>& nivel, vector<int>& fila) const;
+
+    // Os ponteiros do CSR impedem a cópia trivial
+    Grafo(const Grafo&);
+    Grafo& operator=(const Grafo&);
 
 public:
-    
+    // Densidade (2m / n(n-1)) a partir da qual a matriz de bits é construída
+    static const double DENSIDADE_MATRIZ_BITS;
+
     Grafo(int n);
 
-    // Adiciona uma aresta entre u e v (grafo não direcionado)
+    // Cria um grafo já congelado, assumindo os vetores CSR informados, com
+    // linhas já normalizadas (o conteúdo deles é transferido para o grafo)
+    Grafo(int n, long long m, vector<long long>& inicio, vector<int>& adjacentes);
+
+    // Cria um grafo congelado sobre um CSR mapeado em memória; o grafo passa
+    // a ser dono do mapeamento. Sem permitirMatrizBits a matriz densa não é
+    // construída (modo semi-externo: só o estado por vértice fica na memória)
+    Grafo(int n, long long m, ArquivoMapeado* mapa, const long long* inicio, const int* adjacentes,
+          bool permitirMatrizBits = true);
+
+    ~Grafo();
+
+    // Adiciona uma aresta entre u e v (grafo não direcionado).
+    // Se o grafo estiver congelado, volta antes ao modo de construção.
+    // Repetições e laços são descartados ao congelar.
     void adicionarAresta(int u, int v);
 
-    // Retorna os adjacentes de um vértice
-    const vector<int>& getAdjacentes(int v) const;
+    // Converte as listas de adjacência para o formato CSR (normalizado) e as libera
+    void congelar();
+
+    // Ordena cada linha de um CSR e remove laços e vizinhos repetidos,
+    // compactando os vetores. Devolve o número de arestas distintas e conta
+    // os laços e as arestas repetidas descartados.
+    static long long normalizarCSR(int n, vector<long long>& inicio, vector<int>& vizinhos,
+                                   long long& lacos, long long& repetidas);
+    static long long normalizarCSR(int n, long long* inicio, int* vizinhos,
+                                   long long& lacos, long long& repetidas);
+
+    // Indica se o grafo está no formato CSR
+    bool estaCongelado() const;
+
+    // Vetores CSR crus (n + 1 deslocamentos e 2m vizinhos); exige grafo congelado
+    const long long* getInicioVizinhos() const;
+    const int* getVizinhos() const;
+
+    // Retorna os adjacentes de um vértice (no caminho crítico: inline)
+    Vizinhanca getAdjacentes(int v) const {
+        if (congelado) {
+            return Vizinhanca(csrVizinhos + csrInicio[v], csrVizinhos + csrInicio[v + 1]);
+        }
+        const int* base = adj[v].data();
+        return Vizinhanca(base, base + adj[v].size());
+    }
+
+    // Backend denso: constrói (ativar) ou libera a matriz de bits.
+    // Só grafos congelados a admitem; retorna se a matriz ficou ativa.
+    bool usarMatrizBits(bool ativar);
+    bool temMatrizBits() const { return palavrasPorLinha > 0; }
+    int getPalavrasPorLinha() const { return palavrasPorLinha; }
+    const uint64_t* getLinhaBits(int v) const {
+        return matrizBits.data() + (size_t)v * palavrasPorLinha;
+    }
+
+    // Fração dos pares de vértices que são arestas
+    double getDensidade() const;
 
     // Retorna o número de vértices
     int getNumVertices() const;
 
     // Retorna o número de arestas
-    int getNumArestas() const;
+    long long getNumArestas() const;
 
     // Retorna o grau de um vértice
     int getGrau(int v) const;
 
-    // Verifica se existe aresta entre u e v
+    // Ordem smallest-last (Matula e Beck): vértices retirados um a um pelo
+    // menor grau no grafo restante, devolvidos na ordem inversa da retirada
+    // (a ordem de coloração). Listas por grau restante: O(n + m). Se
+    // degeneracao não for nulo, recebe o maior grau no momento de uma retirada.
+    vector<int> ordemSmallestLast(int* degeneracao = nullptr) const;
+
+    // Reordenação: ordem[i] = vértice que passa a ter o identificador i.
+    // reordenar devolve (alocado) o grafo renumerado, já congelado; exige
+    // grafo congelado. RCM e BFS: O((n + m) log grau); grau: O(n log n).
+    vector<int> ordemReordenacao(Reordenacao r) const;
+    Grafo* reordenar(const vector<int>& ordem) const;
+    static bool lerReordenacao(const string& nome, Reordenacao& r);
+    static string nomeReordenacao(Reordenacao r);
+
+    // Verifica se existe aresta entre u e v: O(1) com matriz de bits,
+    // O(log grau) por busca binária sem desvios no CSR
     bool existeAresta(int u, int v) const;
 
-    // Leitura de arquivo no formato padrão
-    static Grafo* lerArquivo(const string& nomeArquivo);
+    // Leitura de arquivo no formato padrão. Problemas de formato são
+    // resumidos em cerr; a segunda versão os devolve no relatório.
+    // Com usarCache, um cache binário ao lado do arquivo é usado quando
+    // válido e (re)escrito quando ausente ou desatualizado.
+    static Grafo* lerArquivo(const string& nomeArquivo, bool usarCache = true);
+    static Grafo* lerArquivo(const string& nomeArquivo, RelatorioLeitura& relatorio,
+                             bool usarCache = true);
 
     // Imprime o grafo
     void imprimir() const;
     
     // Exporta para formato GraphEditor (csacademy.com)
     void exportarGraphEditor(const string& nomeArquivo) const;
+    
+    // Escreve cada aresta uma vez ("u v\n", u < v; fora do CSR, as arestas
+    // adicionadas mais de uma vez saem repetidas, como em getNumArestas());
+    // com rotulos, cada vértice v sai como (*rotulos)[v] (ex.: identificadores originais)
+    void escreverArestas(EscritorAssincrono& saida, const vector<int>* rotulos = nullptr) const;
 };
 
 #endif
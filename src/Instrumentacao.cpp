@@ -0,0 +1,154 @@
+#include "Instrumentacao.h"
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
+thread_local ContadoresInstrumentacao* instrumentacaoAtual = nullptr;
+thread_local CronometroFase* cronometroAtual = nullptr;
+
+// Construtor
+ContadoresInstrumentacao::ContadoresInstrumentacao() {
+    zerar();
+}
+
+// Zera contadores, tempos e traços
+void ContadoresInstrumentacao::zerar() {
+    verificacoesCor = 0;
+    visitasVizinhos = 0;
+    construcoes = 0;
+    selecoesRCL = 0;
+    somaTamanhoRCL = 0;
+    maiorRCL = 0;
+    coresAbertas = 0;
+    for (int f = 0; f < NUM_FASES; f++) {
+        segundosFase[f] = 0.0;
+    }
+    tracos.clear();
+}
+
+// Soma os contadores de outra thread
+void ContadoresInstrumentacao::acumular(const ContadoresInstrumentacao& outros) {
+    verificacoesCor += outros.verificacoesCor;
+    visitasVizinhos += outros.visitasVizinhos;
+    construcoes += outros.construcoes;
+    selecoesRCL += outros.selecoesRCL;
+    somaTamanhoRCL += outros.somaTamanhoRCL;
+    maiorRCL = max(maiorRCL, outros.maiorRCL);
+    coresAbertas += outros.coresAbertas;
+    for (int f = 0; f < NUM_FASES; f++) {
+        segundosFase[f] += outros.segundosFase[f];
+    }
+    if (!outros.tracos.empty()) {
+        tracos.insert(tracos.end(), outros.tracos.begin(), outros.tracos.end());
+        stable_sort(tracos.begin(), tracos.end(),
+                    [](const TracoIteracao& a, const TracoIteracao& b) { return a.iteracao < b.iteracao; });
+    }
+}
+
+// Inicia a fase, suspendendo a contagem da fase externa
+CronometroFase::CronometroFase(int f)
+    : fase(f), inicio(chrono::steady_clock::now()), segundosFilhas(0.0), externa(cronometroAtual) {
+    cronometroAtual = this;
+}
+
+// Registra o tempo exclusivo da fase e o desconta da externa
+CronometroFase::~CronometroFase() {
+    double total = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    if (instrumentacaoAtual != nullptr) {
+        instrumentacaoAtual->segundosFase[fase] += total - segundosFilhas;
+    }
+    if (externa != nullptr) {
+        externa->segundosFilhas += total;
+    }
+    cronometroAtual = externa;
+}
+
+// Liga os contadores da thread
+EscopoInstrumentacao::EscopoInstrumentacao(ContadoresInstrumentacao& contadores)
+    : anterior(instrumentacaoAtual) {
+    instrumentacaoAtual = &contadores;
+}
+
+// Restaura os contadores anteriores
+EscopoInstrumentacao::~EscopoInstrumentacao() {
+    instrumentacaoAtual = anterior;
+}
+
+const char* Instrumentacao::nomeFase(int fase) {
+    switch (fase) {
+        case FASE_LEITURA:
+            return "Leitura";
+        case FASE_CONSTRUCAO:
+            return "Construcao";
+        case FASE_AVALIACAO:
+            return "Avaliacao";
+        case FASE_BUSCA_LOCAL:
+            return "BuscaLocal";
+        case FASE_RELIGACAO:
+            return "Religacao";
+        default:
+            return "Escrita";
+    }
+}
+
+// Colunas dos contadores
+string Instrumentacao::cabecalhoContadores() {
+    string cabecalho = "VerificacoesCor,VisitasVizinhos,Construcoes,SelecoesRCL,TamanhoMedioRCL,"
+                       "MaiorRCL,CoresAbertas";
+    for (int f = 0; f < NUM_FASES; f++) {
+        cabecalho += string(",") + nomeFase(f) + "(s)";
+    }
+    return cabecalho;
+}
+
+string Instrumentacao::linhaContadores(const ContadoresInstrumentacao& c) {
+    ostringstream linha;
+    linha << c.verificacoesCor << "," << c.visitasVizinhos << "," << c.construcoes << ","
+          << c.selecoesRCL << ",";
+    linha << fixed << setprecision(2)
+          << (c.selecoesRCL > 0 ? (double)c.somaTamanhoRCL / c.selecoesRCL : 0.0) << ",";
+    linha << c.maiorRCL << "," << c.coresAbertas;
+    linha << setprecision(6);
+    for (int f = 0; f < NUM_FASES; f++) {
+        linha << "," << c.segundosFase[f];
+    }
+    return linha.str();
+}
+
+// Colunas de um traço
+string Instrumentacao::cabecalhoTraco() {
+    return "Iteracao,Thread,AlphaIteracao,NumCoresIteracao,NumDeficienciasIteracao,TempoDecorrido(s)";
+}
+
+string Instrumentacao::linhaTraco(const TracoIteracao& t) {
+    ostringstream linha;
+    linha << t.iteracao << "," << t.thread << "," << fixed << setprecision(4) << t.alpha << ","
+          << t.numCores << "," << t.numDeficiencias << "," << setprecision(6) << t.tempo;
+    return linha.str();
+}
+
+// resultados.csv -> resultados_<sufixo>.csv
+string Instrumentacao::arquivoDerivado(const string& arquivoResultados, const string& sufixo) {
+    string base = arquivoResultados;
+    if (base.size() >= 4 && base.compare(base.size() - 4, 4, ".csv") == 0) {
+        base.erase(base.size() - 4);
+    }
+    return base + "_" + sufixo + ".csv";
+}
+
+// Resumo legível dos contadores
+void Instrumentacao::imprimir(ostream& saida, const ContadoresInstrumentacao& c) {
+    saida << "\n=== Instrumentacao ===" << endl;
+    saida << "Verificacoes de cor: " << c.verificacoesCor << endl;
+    saida << "Visitas a vizinhos: " << c.visitasVizinhos << endl;
+    saida << "Construcoes: " << c.construcoes << ", cores abertas: " << c.coresAbertas << endl;
+    if (c.selecoesRCL > 0) {
+        saida << "RCL: " << c.selecoesRCL << " escolhas, tamanho medio " << fixed << setprecision(2)
+              << (double)c.somaTamanhoRCL / c.selecoesRCL << ", maior " << c.maiorRCL << endl;
+    }
+    saida << "Tempo por fase (s):";
+    for (int f = 0; f < NUM_FASES; f++) {
+        saida << " " << nomeFase(f) << " " << fixed << setprecision(4) << c.segundosFase[f];
+    }
+    saida << endl;
+}
@@ -0,0 +1,153 @@
+#ifndef INSTRUMENTACAO_H
+#define INSTRUMENTACAO_H
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <ostream>
+
+using namespace std;
+
+// Instrumentação dos pontos quentes, compilada só com -DINSTRUMENTACAO
+// (make INSTRUMENTAR=1). Sem a flag, as macros INSTR_* não geram código e
+// os contadores ficam zerados.
+//
+// Cada thread registra nos contadores apontados por instrumentacaoAtual,
+// ligados a um escopo com INSTR_ESCOPO; as threads de uma execução usam
+// contadores próprios (os da sua AreaTrabalho), somados ao final. As fases
+// são cronometradas com INSTR_FASE em tempo exclusivo: uma fase aninhada
+// (ex.: avaliação dentro da construção) desconta seu tempo da externa.
+
+// Fases cronometradas
+enum FaseInstrumentacao {
+    FASE_LEITURA,       // carga da instância
+    FASE_CONSTRUCAO,    // construções gulosas (RCL e escolha das cores)
+    FASE_AVALIACAO,     // contagem de deficiências
+    FASE_BUSCA_LOCAL,   // busca local
+    FASE_RELIGACAO,     // religação de caminhos entre soluções da elite
+    FASE_ESCRITA,       // CSV e exportações
+    NUM_FASES
+};
+
+// Qualidade de uma iteração do GRASP / Reativo
+struct TracoIteracao {
+    int iteracao;
+    int thread;
+    double alpha;
+    int numCores;
+    int numDeficiencias;
+    double tempo;       // segundos desde o início do algoritmo
+};
+
+// Contadores de uma execução (ou de uma de suas threads)
+struct ContadoresInstrumentacao {
+    long long verificacoesCor;   // pares (vértice, cor) testados
+    long long visitasVizinhos;   // vizinhos percorridos pelo estado (listas de adjacência)
+    long long construcoes;       // construções completas
+    long long selecoesRCL;       // vértices escolhidos na RCL
+    long long somaTamanhoRCL;    // soma dos tamanhos da RCL nas escolhas
+    long long maiorRCL;
+    long long coresAbertas;      // cores novas abertas pelas construções
+    double segundosFase[NUM_FASES];
+    vector<TracoIteracao> tracos;
+
+    ContadoresInstrumentacao();
+
+    void zerar();
+
+    // Soma os contadores de outra thread; os traços ficam ordenados por iteração
+    void acumular(const ContadoresInstrumentacao& outros);
+};
+
+// Cronômetro de uma fase (tempo exclusivo, ver acima)
+class CronometroFase {
+private:
+    int fase;
+    chrono::steady_clock::time_point inicio;
+    double segundosFilhas;      // tempo das fases aninhadas
+    CronometroFase* externa;
+
+    CronometroFase(const CronometroFase&);
+    CronometroFase& operator=(const CronometroFase&);
+
+public:
+    CronometroFase(int f);
+    ~CronometroFase();
+};
+
+// Liga os contadores da thread corrente durante um escopo
+class EscopoInstrumentacao {
+private:
+    ContadoresInstrumentacao* anterior;
+
+    EscopoInstrumentacao(const EscopoInstrumentacao&);
+    EscopoInstrumentacao& operator=(const EscopoInstrumentacao&);
+
+public:
+    EscopoInstrumentacao(ContadoresInstrumentacao& contadores);
+    ~EscopoInstrumentacao();
+};
+
+// Contadores e fase corrente da thread (nullptr fora de um escopo)
+extern thread_local ContadoresInstrumentacao* instrumentacaoAtual;
+extern thread_local CronometroFase* cronometroAtual;
+
+// Formatação dos contadores e traços
+class Instrumentacao {
+public:
+    // true se o programa foi compilado com -DINSTRUMENTACAO
+    static bool habilitada() {
+#ifdef INSTRUMENTACAO
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static const char* nomeFase(int fase);
+
+    // Colunas dos contadores e de um traço (acrescentadas à chave da execução)
+    static string cabecalhoContadores();
+    static string linhaContadores(const ContadoresInstrumentacao& c);
+    static string cabecalhoTraco();
+    static string linhaTraco(const TracoIteracao& t);
+
+    // Arquivo ao lado do CSV de resultados: resultados.csv -> resultados_<sufixo>.csv
+    static string arquivoDerivado(const string& arquivoResultados, const string& sufixo);
+
+    // Resumo legível dos contadores
+    static void imprimir(ostream& saida, const ContadoresInstrumentacao& c);
+};
+
+#ifdef INSTRUMENTACAO
+#define INSTR_ESCOPO(contadores) EscopoInstrumentacao escopoInstrumentacao(contadores)
+#define INSTR_FASE(fase) CronometroFase cronometroFase(fase)
+#define INSTR_CONTAR(campo, n) \
+    do { if (instrumentacaoAtual) instrumentacaoAtual->campo += (n); } while (0)
+#define INSTR_RCL(tamanho) \
+    do { \
+        if (instrumentacaoAtual) { \
+            instrumentacaoAtual->selecoesRCL++; \
+            instrumentacaoAtual->somaTamanhoRCL += (tamanho); \
+            if ((tamanho) > instrumentacaoAtual->maiorRCL) instrumentacaoAtual->maiorRCL = (tamanho); \
+        } \
+    } while (0)
+#define INSTR_TRACO(iter, t, alpha, sol, inicio) \
+    do { \
+        if (instrumentacaoAtual) { \
+            TracoIteracao traco = {(iter), (t), (alpha), (sol).numCores, (sol).numDeficiencias, \
+                chrono::duration<double>(chrono::high_resolution_clock::now() - (inicio)).count()}; \
+            instrumentacaoAtual->tracos.push_back(traco); \
+        } \
+    } while (0)
+#define INSTR_ACUMULAR(destino, origem) (destino).acumular(origem)
+#else
+#define INSTR_ESCOPO(contadores) do {} while (0)
+#define INSTR_FASE(fase) do {} while (0)
+#define INSTR_CONTAR(campo, n) do {} while (0)
+#define INSTR_RCL(tamanho) do {} while (0)
+#define INSTR_TRACO(iter, t, alpha, sol, inicio) do {} while (0)
+#define INSTR_ACUMULAR(destino, origem) do {} while (0)
+#endif
+
+#endif
@@ -0,0 +1,170 @@
+#include "KernelBits.h"
+#include <cstdlib>
+#include <string>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define KERNEL_BITS_X86
+#include <immintrin.h>
+#endif
+
+typedef bool (*FuncaoCorViavel)(const uint64_t*, const uint64_t*, const uint64_t*, int, int);
+
+// Versão escalar, portável
+static bool corViavelEscalar(const uint64_t* linha, const uint64_t* classe,
+                             const uint64_t* saturados, int palavras, int limite) {
+    int total = 0;
+    for (int i = 0; i < palavras; i++) {
+        uint64_t comum = linha[i] & classe[i];
+        if (comum == 0) {
+            continue;
+        }
+        if (comum & saturados[i]) {
+            return false;
+        }
+        total += __builtin_popcountll(comum);
+        if (total > limite) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#ifdef KERNEL_BITS_X86
+
+// Popcount de 256 bits por tabela de nibbles (pshufb); soma dos 4 lanes
+__attribute__((target("avx2")))
+static inline int popcount256(__m256i v) {
+    const __m256i tabela = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i mascara = _mm256_set1_epi8(0x0f);
+    __m256i baixo = _mm256_and_si256(v, mascara);
+    __m256i alto = _mm256_and_si256(_mm256_srli_epi16(v, 4), mascara);
+    __m256i contagem = _mm256_add_epi8(_mm256_shuffle_epi8(tabela, baixo),
+                                       _mm256_shuffle_epi8(tabela, alto));
+    __m256i somas = _mm256_sad_epu8(contagem, _mm256_setzero_si256());
+    __m128i s = _mm_add_epi64(_mm256_castsi256_si128(somas), _mm256_extracti128_si256(somas, 1));
+    return (int)(_mm_cvtsi128_si64(s) + _mm_extract_epi64(s, 1));
+}
+
+// AVX2: 4 palavras por passo; blocos sem bits em comum são pulados com vptest
+__attribute__((target("avx2,popcnt")))
+static bool corViavelAVX2(const uint64_t* linha, const uint64_t* classe,
+                          const uint64_t* saturados, int palavras, int limite) {
+    int total = 0;
+    int i = 0;
+    for (; i + 4 <= palavras; i += 4) {
+        __m256i comum = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(linha + i)),
+                                         _mm256_loadu_si256((const __m256i*)(classe + i)));
+        if (_mm256_testz_si256(comum, comum)) {
+            continue;
+        }
+        if (!_mm256_testz_si256(comum, _mm256_loadu_si256((const __m256i*)(saturados + i)))) {
+            return false;
+        }
+        total += popcount256(comum);
+        if (total > limite) {
+            return false;
+        }
+    }
+    for (; i < palavras; i++) {
+        uint64_t comum = linha[i] & classe[i];
+        if (comum & saturados[i]) {
+            return false;
+        }
+        total += __builtin_popcountll(comum);
+        if (total > limite) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Popcount de 512 bits por tabela de nibbles (AVX-512BW)
+__attribute__((target("avx512f,avx512bw")))
+static inline int popcount512(__m512i v) {
+    // Bytes 0..15 = popcount(0..15), repetidos nos quatro blocos de 128 bits
+    const long long baixos = 0x0302020102010100LL, altos = 0x0403030203020201LL;
+    const __m512i tabela = _mm512_set_epi64(altos, baixos, altos, baixos,
+                                            altos, baixos, altos, baixos);
+    const __m512i mascara = _mm512_set1_epi8(0x0f);
+    __m512i baixo = _mm512_and_si512(v, mascara);
+    __m512i alto = _mm512_and_si512(_mm512_srli_epi16(v, 4), mascara);
+    __m512i contagem = _mm512_add_epi8(_mm512_shuffle_epi8(tabela, baixo),
+                                       _mm512_shuffle_epi8(tabela, alto));
+    alignas(64) uint64_t somas[8];
+    _mm512_store_si512(somas, _mm512_sad_epu8(contagem, _mm512_setzero_si512()));
+    return (int)(somas[0] + somas[1] + somas[2] + somas[3] + somas[4] + somas[5] + somas[6] + somas[7]);
+}
+
+// AVX-512: 8 palavras por passo, com os testes feitos por máscara
+__attribute__((target("avx512f,avx512bw,popcnt")))
+static bool corViavelAVX512(const uint64_t* linha, const uint64_t* classe,
+                            const uint64_t* saturados, int palavras, int limite) {
+    int total = 0;
+    int i = 0;
+    for (; i + 8 <= palavras; i += 8) {
+        __m512i comum = _mm512_and_si512(_mm512_loadu_si512(linha + i),
+                                         _mm512_loadu_si512(classe + i));
+        if (_mm512_test_epi64_mask(comum, comum) == 0) {
+            continue;
+        }
+        if (_mm512_test_epi64_mask(comum, _mm512_loadu_si512(saturados + i)) != 0) {
+            return false;
+        }
+        total += popcount512(comum);
+        if (total > limite) {
+            return false;
+        }
+    }
+    for (; i < palavras; i++) {
+        uint64_t comum = linha[i] & classe[i];
+        if (comum & saturados[i]) {
+            return false;
+        }
+        total += __builtin_popcountll(comum);
+        if (total > limite) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif
+
+// Escolhe a implementação pela CPU. A variável de ambiente KERNEL_BITS
+// (escalar, avx2) restringe a escolha, para comparar as versões.
+static FuncaoCorViavel escolherImplementacao(const char*& nome) {
+    const char* pedido = getenv("KERNEL_BITS");
+    string limite = (pedido != nullptr) ? pedido : "";
+    if (limite == "escalar") {
+        nome = "escalar";
+        return corViavelEscalar;
+    }
+#ifdef KERNEL_BITS_X86
+    __builtin_cpu_init();
+    if (limite != "avx2" && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        nome = "avx512";
+        return corViavelAVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        nome = "avx2";
+        return corViavelAVX2;
+    }
+#endif
+    nome = "escalar";
+    return corViavelEscalar;
+}
+
+static const char* nomeImplementacao = nullptr;
+static const FuncaoCorViavel funcaoCorViavel = escolherImplementacao(nomeImplementacao);
+
+// Cor viável para a linha de adjacência informada
+bool KernelBits::corViavel(const uint64_t* linha, const uint64_t* classe,
+                           const uint64_t* saturados, int palavras, int limite) {
+    return funcaoCorViavel(linha, classe, saturados, palavras, limite);
+}
+
+// Implementação escolhida
+const char* KernelBits::implementacao() {
+    return nomeImplementacao;
+}
@@ -0,0 +1,25 @@
+#ifndef KERNEL_BITS_H
+#define KERNEL_BITS_H
+
+#include <cstdint>
+
+using namespace std;
+
+// Núcleo vetorizado do backend denso da coloração.
+// A pergunta "v pode receber a cor c?" vira operações sobre linhas de bits:
+// comum = linha de adjacência de v AND classe da cor c. A cor é viável se
+// popcount(comum) <= d e se nenhum bit de comum está entre os vértices
+// saturados (que já atingiram d deficiências). A varredura para assim que
+// a resposta é conhecida.
+// A implementação (AVX-512, AVX2 ou escalar) é escolhida uma única vez,
+// pela CPU em que o programa roda.
+class KernelBits {
+public:
+    static bool corViavel(const uint64_t* linha, const uint64_t* classe,
+                          const uint64_t* saturados, int palavras, int limite);
+
+    // Nome da implementação em uso: "avx512", "avx2" ou "escalar"
+    static const char* implementacao();
+};
+
+#endif
@@ -0,0 +1,311 @@
+#include "LeitorInstancia.h"
+#include "ArquivoMapeado.h"
+#include <sstream>
+#include <climits>
+
+// Cursor sobre o texto da instância, com contagem de linhas
+struct Cursor {
+    const char* p;
+    const char* fim;
+    long long linha;
+};
+
+enum ResultadoLinha { LINHA_VAZIA, LINHA_ARESTA, LINHA_MALFORMADA, FIM_ARQUIVO };
+
+// Pula espaços e tabulações (não pula quebras de linha)
+static void pularEspacos(Cursor& c) {
+    while (c.p < c.fim && (*c.p == ' ' || *c.p == '\t' || *c.p == '\r')) {
+        c.p++;
+    }
+}
+
+// Pula espaços e quebras de linha
+static void pularBrancos(Cursor& c) {
+    while (c.p < c.fim && (*c.p == ' ' || *c.p == '\t' || *c.p == '\r' || *c.p == '\n')) {
+        if (*c.p == '\n') {
+            c.linha++;
+        }
+        c.p++;
+    }
+}
+
+// Avança até depois da próxima quebra de linha
+static void pularLinha(Cursor& c) {
+    while (c.p < c.fim && *c.p != '\n') {
+        c.p++;
+    }
+    if (c.p < c.fim) {
+        c.p++;
+        c.linha++;
+    }
+}
+
+// Lê um inteiro com sinal opcional; valores enormes são saturados
+static bool lerInteiro(Cursor& c, long long& valor) {
+    bool negativo = false;
+    if (c.p < c.fim && (*c.p == '-' || *c.p == '+')) {
+        negativo = (*c.p == '-');
+        c.p++;
+    }
+    if (c.p >= c.fim || *c.p < '0' || *c.p > '9') {
+        return false;
+    }
+
+    long long x = 0;
+    while (c.p < c.fim && *c.p >= '0' && *c.p <= '9') {
+        if (x < LLONG_MAX / 10) {
+            x = x * 10 + (*c.p - '0');
+        }
+        c.p++;
+    }
+    valor = negativo ? -x : x;
+    return true;
+}
+
+// Lê uma linha de aresta "u v"
+static ResultadoLinha lerLinhaAresta(Cursor& c, long long& u, long long& v) {
+    pularEspacos(c);
+    if (c.p >= c.fim) {
+        return FIM_ARQUIVO;
+    }
+    if (*c.p == '\n') {
+        c.p++;
+        c.linha++;
+        return LINHA_VAZIA;
+    }
+
+    bool ok = lerInteiro(c, u);
+    if (ok) {
+        const char* antes = c.p;
+        pularEspacos(c);
+        ok = (c.p != antes) && lerInteiro(c, v);
+    }
+    if (ok) {
+        pularEspacos(c);
+        ok = (c.p >= c.fim || *c.p == '\n');
+    }
+
+    pularLinha(c);
+    return ok ? LINHA_ARESTA : LINHA_MALFORMADA;
+}
+
+// Percorre as m linhas de aresta chamando visitar(u, v) para as válidas.
+// Se relatorio não for nulo, registra os problemas encontrados.
+template <typename Visitante>
+static void percorrerArestas(Cursor c, long long m, int n, RelatorioLeitura* relatorio,
+                             Visitante visitar) {
+    long long lidas = 0;
+
+    while (lidas < m) {
+        long long u = 0, v = 0;
+        long long linhaAtual = c.linha;
+        ResultadoLinha resultado = lerLinhaAresta(c, u, v);
+
+        if (resultado == FIM_ARQUIVO) {
+            if (relatorio != nullptr) {
+                ostringstream msg;
+                msg << "esperadas " << m << " arestas, encontradas " << lidas;
+                relatorio->registrar(linhaAtual, msg.str());
+            }
+            return;
+        }
+        if (resultado == LINHA_VAZIA) {
+            continue;
+        }
+
+        lidas++;
+        if (resultado == LINHA_MALFORMADA) {
+            if (relatorio != nullptr) {
+                relatorio->linhasMalformadas++;
+                relatorio->registrar(linhaAtual, "linha malformada (esperado \"u v\")");
+            }
+            continue;
+        }
+        if (u < 0 || v < 0 || u >= n || v >= n) {
+            if (relatorio != nullptr) {
+                ostringstream msg;
+                msg << "aresta invalida: " << u << " - " << v;
+                relatorio->arestasInvalidas++;
+                relatorio->registrar(linhaAtual, msg.str());
+            }
+            continue;
+        }
+
+        visitar((int)u, (int)v);
+    }
+}
+
+// Construtor
+RelatorioLeitura::RelatorioLeitura()
+    : sucesso(false), lidoDoCache(false), arestasLidas(0), arestasInvalidas(0), linhasMalformadas(0),
+      lacos(0), arestasRepetidas(0), totalProblemas(0) {}
+
+// Registra um problema
+void RelatorioLeitura::registrar(long long linha, const string& mensagem) {
+    totalProblemas++;
+    if ((int)erros.size() < MAX_ERROS_DETALHADOS) {
+        ErroLeitura erro;
+        erro.linha = linha;
+        erro.mensagem = mensagem;
+        erros.push_back(erro);
+    }
+}
+
+bool RelatorioLeitura::temProblemas() const {
+    return totalProblemas > 0;
+}
+
+// Imprime um resumo dos problemas
+void RelatorioLeitura::imprimir(ostream& saida, const string& nomeArquivo) const {
+    if (lidoDoCache) {
+        saida << "Leitura de " << nomeArquivo << " (cache binario): o arquivo texto tem "
+              << totalProblemas << " problema(s) de formato; use --sem-cache para detalhes\n";
+        saida.flush();
+        return;
+    }
+
+    saida << "Leitura de " << nomeArquivo << ": " << totalProblemas << " problema(s)";
+    if (arestasInvalidas > 0 || linhasMalformadas > 0) {
+        saida << " (" << arestasInvalidas << " arestas invalidas, "
+              << linhasMalformadas << " linhas malformadas)";
+    }
+    saida << "\n";
+    if (lacos > 0 || arestasRepetidas > 0) {
+        saida << "  descartados: " << lacos << " laco(s) e " << arestasRepetidas
+              << " aresta(s) repetida(s)\n";
+    }
+
+    for (const ErroLeitura& erro : erros) {
+        saida << "  linha " << erro.linha << ": " << erro.mensagem << "\n";
+    }
+    long long detalhaveis = totalProblemas - lacos - arestasRepetidas;
+    if (detalhaveis > (long long)erros.size()) {
+        saida << "  ... e mais " << (detalhaveis - (long long)erros.size()) << " problema(s)\n";
+    }
+    saida.flush();
+}
+
+// Mapeia a instância e lê o cabeçalho; o cursor fica na primeira aresta
+static bool abrirInstancia(const string& nomeArquivo, ArquivoMapeado& arquivo, Cursor& c,
+                           long long& n, long long& m, RelatorioLeitura* relatorio) {
+    if (!arquivo.abrir(nomeArquivo)) {
+        if (relatorio != nullptr) {
+            relatorio->registrar(0, "erro ao abrir arquivo");
+        }
+        return false;
+    }
+
+    c.p = arquivo.getDados();
+    c.fim = c.p + arquivo.getTamanho();
+    c.linha = 1;
+
+    // Cabeçalho: número de vértices e número de arestas
+    n = 0;
+    m = 0;
+    pularBrancos(c);
+    bool ok = lerInteiro(c, n);
+    pularBrancos(c);
+    ok = ok && lerInteiro(c, m);
+    if (!ok || n < 0 || n > INT_MAX || m < 0) {
+        if (relatorio != nullptr) {
+            relatorio->registrar(c.linha, "cabecalho invalido (esperado numero de vertices e de arestas)");
+        }
+        return false;
+    }
+    pularEspacos(c);
+    if (c.p < c.fim && *c.p == '\n') {
+        c.p++;
+        c.linha++;
+    }
+    return true;
+}
+
+// Primeira passada: valida as linhas e monta os deslocamentos do CSR
+bool LeitorInstancia::contarGraus(const string& nomeArquivo, vector<long long>& inicioVizinhos,
+                                  RelatorioLeitura& relatorio) {
+    relatorio = RelatorioLeitura();
+
+    ArquivoMapeado arquivo;
+    Cursor c;
+    long long n, m;
+    if (!abrirInstancia(nomeArquivo, arquivo, c, n, m, &relatorio)) {
+        return false;
+    }
+
+    inicioVizinhos.assign(n + 1, 0);
+    percorrerArestas(c, m, (int)n, &relatorio, [&](int u, int v) {
+        inicioVizinhos[u + 1]++;
+        inicioVizinhos[v + 1]++;
+    });
+
+    for (long long v = 0; v < n; v++) {
+        inicioVizinhos[v + 1] += inicioVizinhos[v];
+    }
+    return true;
+}
+
+// Segunda passada: preenche os vizinhos nas posições exatas, uma janela de
+// vértices por releitura do arquivo
+bool LeitorInstancia::preencherVizinhos(const string& nomeArquivo,
+                                        const vector<long long>& inicioVizinhos, int* vizinhos,
+                                        long long limiteJanela) {
+    ArquivoMapeado arquivo;
+    Cursor c;
+    long long n, m;
+    if (!abrirInstancia(nomeArquivo, arquivo, c, n, m, nullptr) ||
+        n + 1 != (long long)inicioVizinhos.size()) {
+        return false;
+    }
+
+    vector<long long> proximo(inicioVizinhos.begin(), inicioVizinhos.end() - 1);
+    if (limiteJanela <= 0) {
+        percorrerArestas(c, m, (int)n, nullptr, [&](int u, int v) {
+            vizinhos[proximo[u]++] = v;
+            vizinhos[proximo[v]++] = u;
+        });
+        return true;
+    }
+
+    int primeiro = 0;
+    while (primeiro < n) {
+        // Janela [primeiro, ultimo): ao menos um vértice, mesmo de grau maior que o limite
+        int ultimo = primeiro + 1;
+        while (ultimo < n && inicioVizinhos[ultimo + 1] - inicioVizinhos[primeiro] <= limiteJanela) {
+            ultimo++;
+        }
+        percorrerArestas(c, m, (int)n, nullptr, [&](int u, int v) {
+            if (u >= primeiro && u < ultimo) {
+                vizinhos[proximo[u]++] = v;
+            }
+            if (v >= primeiro && v < ultimo) {
+                vizinhos[proximo[v]++] = u;
+            }
+        });
+        primeiro = ultimo;
+    }
+    return true;
+}
+
+// Lê a instância em duas passadas sobre o arquivo mapeado
+Grafo* LeitorInstancia::ler(const string& nomeArquivo, RelatorioLeitura& relatorio) {
+    vector<long long> inicioVizinhos;
+    if (!contarGraus(nomeArquivo, inicioVizinhos, relatorio)) {
+        return nullptr;
+    }
+
+    int n = (int)inicioVizinhos.size() - 1;
+    vector<int> vizinhos(inicioVizinhos[n]);
+    if (!preencherVizinhos(nomeArquivo, inicioVizinhos, vizinhos.data())) {
+        relatorio.registrar(0, "erro ao reler arquivo");
+        return nullptr;
+    }
+
+    // Ordena as linhas e descarta laços e repetições
+    long long distintas = Grafo::normalizarCSR(n, inicioVizinhos, vizinhos,
+                                               relatorio.lacos, relatorio.arestasRepetidas);
+    relatorio.totalProblemas += relatorio.lacos + relatorio.arestasRepetidas;
+
+    relatorio.arestasLidas = distintas;
+    relatorio.sucesso = true;
+    return new Grafo(n, distintas, inicioVizinhos, vizinhos);
+}
@@ -0,0 +1,66 @@
+#ifndef LEITOR_INSTANCIA_H
+#define LEITOR_INSTANCIA_H
+
+#include "Grafo.h"
+#include <vector>
+#include <string>
+#include <iostream>
+
+using namespace std;
+
+// Problema encontrado na leitura de uma instância
+struct ErroLeitura {
+    long long linha;     // linha do arquivo (a partir de 1)
+    string mensagem;
+};
+
+// Relatório estruturado da leitura de uma instância
+struct RelatorioLeitura {
+    bool sucesso;                 // false se a instância não pôde ser carregada
+    bool lidoDoCache;             // grafo veio do cache binário
+    long long arestasLidas;       // arestas válidas adicionadas ao grafo
+    long long arestasInvalidas;   // arestas com vértice fora do intervalo
+    long long linhasMalformadas;  // linhas que não são um par de inteiros
+    long long lacos;              // arestas u - u descartadas
+    long long arestasRepetidas;   // repetições de arestas já lidas, descartadas
+    long long totalProblemas;     // total de problemas (inclusive os não detalhados)
+    vector<ErroLeitura> erros;    // primeiros problemas, com a linha de origem
+
+    static const int MAX_ERROS_DETALHADOS = 20;
+
+    RelatorioLeitura();
+
+    // Registra um problema (só os primeiros são guardados com detalhes)
+    void registrar(long long linha, const string& mensagem);
+
+    bool temProblemas() const;
+
+    // Imprime um resumo dos problemas
+    void imprimir(ostream& saida, const string& nomeArquivo) const;
+};
+
+// Leitor de instâncias no formato padrão (n, m e m linhas "u v").
+// O arquivo é mapeado em memória e percorrido duas vezes por um analisador
+// próprio: a primeira passada valida as linhas e conta os graus, a segunda
+// preenche o CSR já com o tamanho exato, sem realocações por aresta. Por fim
+// as linhas são ordenadas e os laços e arestas repetidas, descartados.
+class LeitorInstancia {
+public:
+    static Grafo* ler(const string& nomeArquivo, RelatorioLeitura& relatorio);
+
+    // As duas passadas em separado, para montar o CSR fora da memória do
+    // processo (ex.: direto num arquivo mapeado). contarGraus devolve os n + 1
+    // deslocamentos e registra os problemas de formato; preencherVizinhos
+    // grava os 2m vizinhos (linhas ainda não normalizadas) em vizinhos.
+    // Com limiteJanela > 0 os vértices são divididos em janelas de no máximo
+    // limiteJanela vizinhos (ou um único vértice) e o arquivo é relido uma
+    // vez por janela, gravando só as linhas dela: as escritas ficam restritas
+    // a um trecho contíguo de vizinhos por vez (0 = uma única passada).
+    static bool contarGraus(const string& nomeArquivo, vector<long long>& inicioVizinhos,
+                            RelatorioLeitura& relatorio);
+    static bool preencherVizinhos(const string& nomeArquivo,
+                                  const vector<long long>& inicioVizinhos, int* vizinhos,
+                                  long long limiteJanela = 0);
+};
+
+#endif
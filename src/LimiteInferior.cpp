@@ -0,0 +1,207 @@
+#include "LimiteInferior.h"
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+
+using namespace std;
+
+// Orçamento da busca do clique, em operações elementares (pares de
+// vizinhos testados ao montar as linhas e palavras / candidatos visitados
+// por nó), somado em todas as raízes. Esgotado, a raiz corrente termina
+// por descida gulosa (cada nível segue só o primeiro candidato) e as
+// demais raízes são descartadas: o clique deixa de ser garantidamente máximo.
+static const long long LIMITE_TRABALHO = 1LL << 24;
+
+static int contarBits(const vector<uint64_t>& conjunto) {
+    int total = 0;
+    for (uint64_t palavra : conjunto) {
+        total += __builtin_popcountll(palavra);
+    }
+    return total;
+}
+
+// Calcula a ordem smallest-last, as arestas dos prefixos e o clique
+LimiteInferior::LimiteInferior(const Grafo& g)
+    : numVertices(g.getNumVertices()), grauMaximo(0), degeneracao(0), clique(0),
+      cliqueExato(true), tempo(0.0), palavras(0), trabalho(0) {
+    auto inicio = chrono::steady_clock::now();
+    int n = numVertices;
+    vector<int> ordem = g.ordemSmallestLast(&degeneracao);
+
+    for (int v = 0; v < n; v++) {
+        grauMaximo = max(grauMaximo, g.getGrau(v));
+    }
+
+    // anteriores[i] = vizinhos de ordem[i] em ordem[0 .. i) (no máximo
+    // degeneração deles); arestasPrefixo[i] = arestas entre ordem[0 .. i]
+    vector<int> posicao(n);
+    for (int i = 0; i < n; i++) {
+        posicao[ordem[i]] = i;
+    }
+    vector<int> anteriores(n, 0);
+    arestasPrefixo.resize(n);
+    long long total = 0;
+    for (int i = 0; i < n; i++) {
+        for (int u : g.getAdjacentes(ordem[i])) {
+            if (posicao[u] < i) {
+                anteriores[i]++;
+            }
+        }
+        total += anteriores[i];
+        arestasPrefixo[i] = total;
+    }
+
+    procurarClique(g, ordem, posicao, anteriores);
+    tempo = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+}
+
+// Todo clique tem um último vértice na ordem, e os demais estão entre os
+// vizinhos anteriores dele: basta procurar, para cada raiz, um clique
+// nesses vizinhos. As raízes com mais vizinhos anteriores vêm primeiro, e
+// as que não podem superar o clique corrente são descartadas.
+void LimiteInferior::procurarClique(const Grafo& g, const vector<int>& ordem,
+                                    const vector<int>& posicao, const vector<int>& anteriores) {
+    int n = numVertices;
+    if (n == 0) {
+        return;
+    }
+    clique = 1;
+
+    // Raízes por número de vizinhos anteriores decrescente (contagem)
+    vector<int> inicioFaixa(degeneracao + 2, 0);
+    for (int i = 0; i < n; i++) {
+        inicioFaixa[degeneracao - anteriores[i] + 1]++;
+    }
+    for (int k = 1; k <= degeneracao + 1; k++) {
+        inicioFaixa[k] += inicioFaixa[k - 1];
+    }
+    vector<int> raizes(n);
+    for (int i = 0; i < n; i++) {
+        raizes[inicioFaixa[degeneracao - anteriores[i]]++] = i;
+    }
+
+    vector<int> vizinhos;
+    for (int i : raizes) {
+        int k = anteriores[i];
+        if (k + 1 <= clique) {
+            break;
+        }
+        if (trabalho >= LIMITE_TRABALHO) {
+            cliqueExato = false;
+            break;
+        }
+        trabalho += (long long)k * (k - 1) / 2;
+        int raiz = ordem[i];
+        vizinhos.clear();
+        for (int u : g.getAdjacentes(raiz)) {
+            if (posicao[u] < i) {
+                vizinhos.push_back(u);
+            }
+        }
+
+        // Adjacência entre os vizinhos anteriores, em linhas de bits locais
+        palavras = (k + 63) / 64;
+        linhas.assign((size_t)k * palavras, 0);
+        grauLocal.assign(k, 0);
+        for (int a = 0; a < k; a++) {
+            for (int b = 0; b < a; b++) {
+                if (g.existeAresta(vizinhos[a], vizinhos[b])) {
+                    linhas[(size_t)a * palavras + (b >> 6)] |= 1ULL << (b & 63);
+                    linhas[(size_t)b * palavras + (a >> 6)] |= 1ULL << (a & 63);
+                    grauLocal[a]++;
+                    grauLocal[b]++;
+                }
+            }
+        }
+
+        if ((int)candidatos.size() < k + 2) {
+            candidatos.resize(k + 2);
+        }
+        vector<uint64_t>& todos = candidatos[0];
+        todos.assign(palavras, ~0ULL);
+        if (k % 64 != 0) {
+            todos[palavras - 1] = (1ULL << (k % 64)) - 1;
+        }
+        expandir(0, 1);
+    }
+}
+
+// Ramificação sobre os candidatos do nível (todos adjacentes ao clique
+// corrente, de tamanho tamanho), pelo maior grau local primeiro; poda
+// quando nem todos os candidatos juntos superariam o melhor clique
+void LimiteInferior::expandir(int nivel, int tamanho) {
+    int restantes = contarBits(candidatos[nivel]);
+    if (restantes == 0) {
+        clique = max(clique, tamanho);
+        return;
+    }
+    bool primeiro = true;
+    while (restantes > 0 && tamanho + restantes > clique) {
+        if (!primeiro && trabalho >= LIMITE_TRABALHO) {
+            cliqueExato = false;
+            return;
+        }
+        primeiro = false;
+        trabalho += palavras + restantes;
+
+        vector<uint64_t>& cand = candidatos[nivel];
+        int x = -1;
+        for (int w = 0; w < palavras; w++) {
+            uint64_t bits = cand[w];
+            while (bits != 0) {
+                int y = w * 64 + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                if (x < 0 || grauLocal[y] > grauLocal[x]) {
+                    x = y;
+                }
+            }
+        }
+
+        vector<uint64_t>& proximo = candidatos[nivel + 1];
+        proximo.resize(palavras);
+        const uint64_t* linha = linhas.data() + (size_t)x * palavras;
+        for (int w = 0; w < palavras; w++) {
+            proximo[w] = cand[w] & linha[w];
+        }
+        cand[x >> 6] &= ~(1ULL << (x & 63));
+        restantes--;
+        expandir(nivel + 1, tamanho + 1);
+    }
+}
+
+// ceil(omega / (d + 1))
+int LimiteInferior::porClique(int d) const {
+    return (clique + d) / (d + 1);
+}
+
+// max sobre os prefixos p da ordem de ceil(p^2 / (p^2 - 2m_p + p d))
+int LimiteInferior::porDensidade(int d) const {
+    int melhor = 0;
+    for (int i = 0; i < numVertices; i++) {
+        long long p = i + 1;
+        long long denominador = p * p - 2 * arestasPrefixo[i] + p * d;
+        melhor = max(melhor, (int)((p * p + denominador - 1) / denominador));
+    }
+    return melhor;
+}
+
+// Uma cor só basta se nenhum vértice tem mais de d vizinhos
+int LimiteInferior::porGrau(int d) const {
+    if (numVertices == 0) {
+        return 0;
+    }
+    return grauMaximo > d ? 2 : 1;
+}
+
+int LimiteInferior::limite(int d) const {
+    return max(porClique(d), max(porDensidade(d), porGrau(d)));
+}
+
+string LimiteInferior::descrever(int d) const {
+    ostringstream texto;
+    texto << limite(d) << " (clique " << (cliqueExato ? "maximo " : "heuristico ") << clique
+          << " -> " << porClique(d) << ", densidade -> " << porDensidade(d)
+          << ", grau -> " << porGrau(d) << "; " << fixed << setprecision(4) << tempo << " s)";
+    return texto.str();
+}
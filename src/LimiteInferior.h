@@ -0,0 +1,70 @@
+#ifndef LIMITE_INFERIOR_H
+#define LIMITE_INFERIOR_H
+
+#include "Grafo.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+// Limites inferiores para o número de cores de uma coloração defeituosa
+// (cada vértice com no máximo d vizinhos da mesma cor), usados para
+// certificar a otimalidade de uma solução e parar o GRASP / Reativo assim
+// que ela é atingida.
+//
+// - Clique: uma cor tem no máximo d + 1 vértices de um clique, logo são
+//   necessárias ceil(omega / (d + 1)) cores. O clique é procurado a partir
+//   de cada vértice entre os seus vizinhos anteriores na ordem smallest-last
+//   (no máximo degeneração deles), com conjuntos de candidatos em bits e
+//   poda por popcount; a busca é exata até um orçamento de operações e,
+//   esgotado ele, gulosa (o clique encontrado continua sendo um limite).
+// - Densidade: cada classe induz grau máximo d, então com k cores
+//   2m <= n d + n^2 (1 - 1/k), ou seja k >= n^2 / (n^2 - 2m + n d). Vale
+//   para qualquer subgrafo induzido; é avaliado em todos os prefixos da
+//   ordem smallest-last (os núcleos do grafo), em O(n) por valor de d.
+// - Grau: se algum vértice tem mais de d vizinhos, uma cor não basta.
+//
+// Os invariantes do grafo são calculados uma única vez no construtor e
+// servem para qualquer d.
+class LimiteInferior {
+private:
+    int numVertices;
+    int grauMaximo;
+    int degeneracao;
+    int clique;                     // tamanho do maior clique encontrado
+    bool cliqueExato;               // a busca terminou dentro do orçamento
+    vector<long long> arestasPrefixo; // arestas induzidas pelos i + 1 primeiros da ordem
+    double tempo;                   // segundos gastos no construtor
+
+    // Busca do clique: linhas de adjacência locais (vizinhos anteriores da
+    // raiz) e um conjunto de candidatos por nível da recursão
+    vector<uint64_t> linhas;
+    vector<vector<uint64_t>> candidatos;
+    vector<int> grauLocal;
+    int palavras;
+    long long trabalho;             // operações gastas (ver LIMITE_TRABALHO)
+
+    void procurarClique(const Grafo& g, const vector<int>& ordem, const vector<int>& posicao,
+                        const vector<int>& anteriores);
+    void expandir(int nivel, int tamanho);
+
+public:
+    LimiteInferior(const Grafo& g);
+
+    // Limites para o parâmetro d (o maior deles é o limite da instância)
+    int porClique(int d) const;
+    int porDensidade(int d) const;
+    int porGrau(int d) const;
+    int limite(int d) const;
+
+    int getClique() const { return clique; }
+    bool isCliqueExato() const { return cliqueExato; }
+    int getDegeneracao() const { return degeneracao; }
+    double getTempo() const { return tempo; }
+
+    // Resumo em uma linha: valor, origem e tempo
+    string descrever(int d) const;
+};
+
+#endif
@@ -0,0 +1,33 @@
+#include "MedidorMemoria.h"
+#include <fstream>
+#include <string>
+#include <cstdlib>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+// Pico de memória residente
+long MedidorMemoria::picoResidenteKB() {
+#ifndef _WIN32
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) == 0) {
+        return uso.ru_maxrss;
+    }
+#endif
+    return -1;
+}
+
+// Memória anônima residente, lida de /proc/self/status
+long MedidorMemoria::anonimaKB() {
+    ifstream status("/proc/self/status");
+    string linha;
+    while (getline(status, linha)) {
+        if (linha.compare(0, 8, "RssAnon:") == 0) {
+            return atol(linha.c_str() + 8);
+        }
+    }
+    return -1;
+}
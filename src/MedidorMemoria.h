@@ -0,0 +1,16 @@
+#ifndef MEDIDOR_MEMORIA_H
+#define MEDIDOR_MEMORIA_H
+
+// Consumo de memória do processo, em KB (-1 se indisponível no sistema).
+// O pico residente inclui as páginas de arquivos mapeados que foram lidas;
+// a memória anônima (heap e pilhas) é a parte que não volta para o disco.
+class MedidorMemoria {
+public:
+    // Pico de memória residente (getrusage)
+    static long picoResidenteKB();
+
+    // Memória anônima residente no momento (RssAnon, só no Linux)
+    static long anonimaKB();
+};
+
+#endif
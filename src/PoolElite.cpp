@@ -0,0 +1,92 @@
+#include "PoolElite.h"
+#include <algorithm>
+
+using namespace std;
+
+// Candidatas guardadas por vaga da elite: folga para o filtro de diversidade
+static const int CANDIDATAS_POR_VAGA = 4;
+
+// Construtor
+PoolElite::PoolElite(int tamanho)
+    : capacidade(max(tamanho, 0)), maxCandidatas(max(tamanho, 0) * CANDIDATAS_POR_VAGA),
+      numElite(0) {
+    candidatas.reserve(maxCandidatas);
+}
+
+// Ordem total das candidatas: menos cores, menos deficiências, iteração anterior
+bool PoolElite::antes(const Solucao& a, int ia, const Solucao& b, int ib) {
+    if (a.numCores != b.numCores) {
+        return a.numCores < b.numCores;
+    }
+    if (a.numDeficiencias != b.numDeficiencias) {
+        return a.numDeficiencias < b.numDeficiencias;
+    }
+    return ia < ib;
+}
+
+// Mantém as maxCandidatas melhores soluções distintas
+void PoolElite::oferecer(const Solucao& sol, int iteracao) {
+    if (maxCandidatas == 0) {
+        return;
+    }
+    
+    // Solução repetida: fica a da iteração de menor índice
+    for (Candidata& c : candidatas) {
+        if (c.sol.numCores == sol.numCores && c.sol.numDeficiencias == sol.numDeficiencias &&
+            c.sol.cores == sol.cores) {
+            c.iteracao = min(c.iteracao, iteracao);
+            return;
+        }
+    }
+    
+    if ((int)candidatas.size() < maxCandidatas) {
+        candidatas.push_back(Candidata());
+        candidatas.back().sol = sol;
+        candidatas.back().iteracao = iteracao;
+        return;
+    }
+    
+    // Substitui a pior, se a nova vier antes dela (reaproveita o buffer de cores)
+    int pior = 0;
+    for (int i = 1; i < (int)candidatas.size(); i++) {
+        if (antes(candidatas[pior].sol, candidatas[pior].iteracao,
+                  candidatas[i].sol, candidatas[i].iteracao)) {
+            pior = i;
+        }
+    }
+    if (antes(sol, iteracao, candidatas[pior].sol, candidatas[pior].iteracao)) {
+        candidatas[pior].sol = sol;
+        candidatas[pior].iteracao = iteracao;
+    }
+}
+
+// União com as candidatas de outro pool
+void PoolElite::mesclar(const PoolElite& outro) {
+    for (const Candidata& c : outro.candidatas) {
+        oferecer(c.sol, c.iteracao);
+    }
+}
+
+// Seleção gulosa na ordem das candidatas, exigindo distância mínima entre
+// as escolhidas; a elite ocupa o início de candidatas
+int PoolElite::selecionar(int distanciaMinima) {
+    sort(candidatas.begin(), candidatas.end(), [](const Candidata& a, const Candidata& b) {
+        return antes(a.sol, a.iteracao, b.sol, b.iteracao);
+    });
+    
+    numElite = 0;
+    for (int i = 0; i < (int)candidatas.size() && numElite < capacidade; i++) {
+        const Solucao& s = candidatas[i].sol;
+        bool diversa = true;
+        for (int j = 0; j < numElite && diversa; j++) {
+            const Solucao& e = candidatas[j].sol;
+            diversa = casamento.distancia(s.cores, s.numCores, e.cores, e.numCores) >=
+                      distanciaMinima;
+        }
+        if (diversa) {
+            swap(candidatas[numElite], candidatas[i]);
+            numElite++;
+        }
+    }
+    return numElite;
+}
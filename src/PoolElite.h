@@ -0,0 +1,52 @@
+#ifndef POOL_ELITE_H
+#define POOL_ELITE_H
+
+#include "ColoracaoDefeituosa.h"
+#include "CasamentoCores.h"
+#include <vector>
+
+using namespace std;
+
+// Conjunto elite do GRASP / Reativo: as melhores soluções construídas,
+// distintas entre si, entre as quais a religação de caminhos é feita.
+//
+// Durante as iterações cada thread oferece as suas soluções ao próprio
+// pool, que guarda as maxCandidatas melhores pela ordem (numCores,
+// numDeficiencias, iteração). Como essa ordem é total, as melhores da
+// união dos pools das threads (mesclar) são as mesmas que um único pool
+// serial guardaria, com qualquer número de threads. Ao final, selecionar()
+// percorre as candidatas nessa ordem e aceita cada uma que esteja a pelo
+// menos distanciaMinima vértices de todas as já aceitas (distância de
+// Hamming após casar as classes de cor, ver CasamentoCores).
+class PoolElite {
+private:
+    struct Candidata {
+        Solucao sol;
+        int iteracao;       // iteração que gerou a solução
+    };
+
+    int capacidade;         // tamanho máximo da elite
+    int maxCandidatas;      // candidatas guardadas até a seleção
+    vector<Candidata> candidatas;
+    int numElite;           // após selecionar(): candidatas[0 .. numElite) são a elite
+    CasamentoCores casamento;
+
+    static bool antes(const Solucao& a, int ia, const Solucao& b, int ib);
+
+public:
+    PoolElite(int tamanho);
+
+    // Considera a solução de uma iteração (copia as cores só se ela entra)
+    void oferecer(const Solucao& sol, int iteracao);
+
+    // Acrescenta as candidatas de outro pool (o de outra thread)
+    void mesclar(const PoolElite& outro);
+
+    // Escolhe a elite entre as candidatas; retorna o seu tamanho
+    int selecionar(int distanciaMinima);
+
+    int tamanho() const { return numElite; }
+    const Solucao& getElite(int i) const { return candidatas[i].sol; }
+};
+
+#endif
@@ -0,0 +1,71 @@
+#include "PoolTarefas.h"
+#include <thread>
+#include <algorithm>
+
+// Construtor
+PoolTarefas::PoolTarefas(int numTrabalhadores) : proxima(0) {
+    if (numTrabalhadores <= 0) {
+        numTrabalhadores = max(1, (int)thread::hardware_concurrency());
+    }
+    for (int t = 0; t < numTrabalhadores; t++) {
+        filas.push_back(new FilaTrabalhador());
+    }
+}
+
+// Destrutor
+PoolTarefas::~PoolTarefas() {
+    for (FilaTrabalhador* fila : filas) {
+        delete fila;
+    }
+}
+
+// Distribui as tarefas em rodízio entre os trabalhadores
+void PoolTarefas::adicionar(function<void()> tarefa) {
+    FilaTrabalhador& fila = *filas[proxima];
+    {
+        lock_guard<mutex> guarda(fila.trava);
+        fila.tarefas.push_back(move(tarefa));
+    }
+    proxima = (proxima + 1) % filas.size();
+}
+
+// Frente da própria fila; senão, o fim da primeira fila não vazia a seguir
+bool PoolTarefas::obter(int t, function<void()>& tarefa) {
+    int total = filas.size();
+    for (int i = 0; i < total; i++) {
+        FilaTrabalhador& fila = *filas[(t + i) % total];
+        lock_guard<mutex> guarda(fila.trava);
+        if (fila.tarefas.empty()) {
+            continue;
+        }
+        if (i == 0) {
+            tarefa = move(fila.tarefas.front());
+            fila.tarefas.pop_front();
+        } else {
+            tarefa = move(fila.tarefas.back());
+            fila.tarefas.pop_back();
+        }
+        return true;
+    }
+    return false;
+}
+
+// Como nenhuma tarefa cria outras, todas as filas vazias encerram o trabalhador
+void PoolTarefas::trabalhar(int t) {
+    function<void()> tarefa;
+    while (obter(t, tarefa)) {
+        tarefa();
+    }
+}
+
+// Executa o lote com um trabalhador por fila
+void PoolTarefas::executar() {
+    vector<thread> threads;
+    for (int t = 1; t < (int)filas.size(); t++) {
+        threads.push_back(thread([this, t]() { trabalhar(t); }));
+    }
+    trabalhar(0);
+    for (thread& th : threads) {
+        th.join();
+    }
+}
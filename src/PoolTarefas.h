@@ -0,0 +1,49 @@
+#ifndef POOL_TAREFAS_H
+#define POOL_TAREFAS_H
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+// Pool de threads com roubo de tarefas para um lote conhecido de antemão.
+// Cada trabalhador tem a sua fila: as tarefas são distribuídas em rodízio
+// por adicionar() e, em executar(), cada trabalhador consome a frente da
+// própria fila; quando ela esvazia, rouba do fim da fila de outro. Com as
+// tarefas adicionadas da mais cara para a mais barata, cada um começa pelas
+// caras e os roubos do fim do lote pegam as baratas, equilibrando a carga.
+// As tarefas não podem adicionar novas tarefas durante executar().
+class PoolTarefas {
+private:
+    struct FilaTrabalhador {
+        mutex trava;
+        deque<function<void()>> tarefas;
+    };
+
+    vector<FilaTrabalhador*> filas;
+    int proxima;            // fila que recebe a próxima tarefa
+
+    // Próxima tarefa do trabalhador t (da própria fila ou roubada)
+    bool obter(int t, function<void()>& tarefa);
+    void trabalhar(int t);
+
+    PoolTarefas(const PoolTarefas&);
+    PoolTarefas& operator=(const PoolTarefas&);
+
+public:
+    // numTrabalhadores <= 0 usa o número de núcleos
+    PoolTarefas(int numTrabalhadores);
+    ~PoolTarefas();
+
+    int getNumTrabalhadores() const { return filas.size(); }
+
+    void adicionar(function<void()> tarefa);
+
+    // Executa todas as tarefas e retorna quando terminarem; a thread
+    // chamadora é o trabalhador 0
+    void executar();
+};
+
+#endif
@@ -0,0 +1,145 @@
+#include "ReligacaoCaminhos.h"
+#include "ColoracaoDefeituosa.h"
+#include <algorithm>
+#include <climits>
+
+using namespace std;
+
+// Vértices avaliados por passo do caminho
+static const int AMOSTRA_POR_PASSO = 16;
+
+// Construtor
+ReligacaoCaminhos::ReligacaoCaminhos(const Grafo& g, int deficiencia)
+    : grafo(g), d(deficiencia), estado(g, deficiencia) {
+    int n = grafo.getNumVertices();
+    inicialCasada.reserve(n);
+    diferentes.reserve(n);
+    caminho.reserve(n);
+}
+
+// Mesmo cálculo da BuscaLocal para uma única cor:
+//   excesso novo de v - excesso atual de v
+//   - vizinhos da cor atual acima de d + vizinhos da nova cor já com d ou mais
+int ReligacaoCaminhos::ganhoExcesso(int v, int cor) const {
+    int atual = estado.getCor(v);
+    int lacos = 0, naCor = 0, reducao = 0, aumento = 0;
+    
+    for (int u : grafo.getAdjacentes(v)) {
+        if (u == v) {
+            lacos++;
+            continue;
+        }
+        int c = estado.getCor(u);
+        if (c == atual) {
+            reducao += (estado.getDeficiencias(u) > d);
+        } else if (c == cor) {
+            naCor++;
+            aumento += (estado.getDeficiencias(u) >= d);
+        }
+    }
+    return max(0, naCor + lacos - d) - max(0, estado.getDeficiencias(v) - d) - reducao + aumento;
+}
+
+// Caminho da inicial até a guia, guardando o melhor passo válido
+bool ReligacaoCaminhos::religar(const Solucao& inicial, const Solucao& guia, uint64_t semente,
+                                Solucao& resultado) {
+    int n = grafo.getNumVertices();
+    gerador.semear(semente);
+    
+    // Renomeia as classes da inicial para as cores da guia
+    casamento.casar(inicial.cores, inicial.numCores, guia.cores, guia.numCores, correspondencia);
+    int numRotulos = guia.numCores;
+    for (int c : correspondencia) {
+        numRotulos = max(numRotulos, c + 1);
+    }
+    inicialCasada.resize(n);
+    diferentes.clear();
+    for (int v = 0; v < n; v++) {
+        inicialCasada[v] = correspondencia[inicial.cores[v]];
+        if (inicialCasada[v] != guia.cores[v]) {
+            diferentes.push_back(v);
+        }
+    }
+    
+    // Sem intermediária fora das extremidades
+    if (diferentes.size() < 2) {
+        return false;
+    }
+    
+    estado.carregar(inicialCasada);
+    int classes = 0;
+    for (int c = 0; c < numRotulos; c++) {
+        classes += (estado.getTamanhoClasse(c) > 0);
+    }
+    
+    caminho.clear();
+    int melhorPasso = -1;
+    int melhorClasses = INT_MAX;
+    int melhorDeficiencias = INT_MAX;
+    
+    // O último vértice não é movido: o passo final seria a própria guia
+    while (diferentes.size() > 1) {
+        int restantes = diferentes.size();
+        int escolhido = -1, melhorGanho = 0, empates = 0;
+        for (int i = 0; i < min(restantes, AMOSTRA_POR_PASSO); i++) {
+            int pos = (restantes <= AMOSTRA_POR_PASSO) ? i : (int)gerador.limitado(restantes);
+            int v = diferentes[pos];
+            int ganho = ganhoExcesso(v, guia.cores[v]);
+            if (escolhido == -1 || ganho < melhorGanho) {
+                escolhido = pos;
+                melhorGanho = ganho;
+                empates = 1;
+            } else if (ganho == melhorGanho) {
+                empates++;
+                if (gerador.limitado(empates) == 0) {
+                    escolhido = pos;
+                }
+            }
+        }
+        
+        int v = diferentes[escolhido];
+        diferentes[escolhido] = diferentes.back();
+        diferentes.pop_back();
+        
+        int anterior = estado.getCor(v);
+        estado.recolorir(v, guia.cores[v]);
+        classes -= (estado.getTamanhoClasse(anterior) == 0);
+        classes += (estado.getTamanhoClasse(guia.cores[v]) == 1);
+        caminho.push_back(v);
+        
+        if (estado.getExcesso() == 0 &&
+            (classes < melhorClasses ||
+             (classes == melhorClasses && estado.totalDeficiencias() < melhorDeficiencias))) {
+            melhorPasso = caminho.size();
+            melhorClasses = classes;
+            melhorDeficiencias = estado.totalDeficiencias();
+        }
+    }
+    
+    if (melhorPasso < 0) {
+        return false;
+    }
+    
+    // Refaz os movimentos até o melhor passo e compacta as cores usadas
+    for (int i = 0; i < melhorPasso; i++) {
+        inicialCasada[caminho[i]] = guia.cores[caminho[i]];
+    }
+    novoRotulo.assign(numRotulos, -1);
+    for (int v = 0; v < n; v++) {
+        novoRotulo[inicialCasada[v]] = 0;
+    }
+    int k = 0;
+    for (int c = 0; c < numRotulos; c++) {
+        if (novoRotulo[c] == 0) {
+            novoRotulo[c] = k++;
+        }
+    }
+    resultado.cores.resize(n);
+    for (int v = 0; v < n; v++) {
+        resultado.cores[v] = novoRotulo[inicialCasada[v]];
+    }
+    resultado.numCores = k;
+    resultado.numDeficiencias = melhorDeficiencias;
+    resultado.valida = true;
+    return true;
+}
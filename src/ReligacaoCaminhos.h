@@ -0,0 +1,51 @@
+#ifndef RELIGACAO_CAMINHOS_H
+#define RELIGACAO_CAMINHOS_H
+
+#include "Grafo.h"
+#include "EstadoColoracao.h"
+#include "CasamentoCores.h"
+#include "GeradorAleatorio.h"
+#include <vector>
+
+using namespace std;
+
+struct Solucao;
+
+// Religação de caminhos entre duas soluções da elite. As classes da
+// solução inicial são casadas com as da guia (CasamentoCores) e, a cada
+// passo, um dos vértices que ainda diferem da guia recebe a cor que tem
+// nela: entre uma amostra desses vértices, o movimento de menor ganho de
+// excesso (deficiências acima de d), avaliado em O(grau) a partir das
+// deficiências mantidas pelo EstadoColoracao. O caminho visita colorações
+// intermediárias que misturam as duas soluções; a melhor delas que seja
+// válida (menos classes não vazias e, em empate, menos deficiências),
+// excluídas as extremidades, é devolvida para a busca local.
+class ReligacaoCaminhos {
+private:
+    const Grafo& grafo;
+    int d;
+
+    EstadoColoracao estado;
+    CasamentoCores casamento;
+    GeradorAleatorio gerador;
+
+    vector<int> correspondencia;  // classe da inicial -> cor da guia
+    vector<int> inicialCasada;    // cores da inicial com os rótulos da guia
+    vector<int> diferentes;       // vértices ainda com cor diferente da guia
+    vector<int> caminho;          // vértices movidos, em ordem
+    vector<int> novoRotulo;       // compactação das cores do resultado
+
+    // Variação do excesso ao mover v para a cor informada
+    int ganhoExcesso(int v, int cor) const;
+
+public:
+    ReligacaoCaminhos(const Grafo& g, int deficiencia);
+
+    // Percorre o caminho de inicial até guia (ambas válidas e completas).
+    // Retorna true e grava em resultado (cores, numCores, numDeficiencias,
+    // valida) a melhor intermediária válida, ou false se não houver.
+    bool religar(const Solucao& inicial, const Solucao& guia, uint64_t semente,
+                 Solucao& resultado);
+};
+
+#endif
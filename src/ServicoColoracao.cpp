@@ -0,0 +1,441 @@
+#include "ServicoColoracao.h"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <csignal>
+#include <cstring>
+#include <cerrno>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+// Maior linha aceita numa requisição
+static const size_t TAMANHO_MAXIMO_LINHA = 1 << 16;
+
+// Intervalo (ms) em que a espera por conexões confere o pedido de encerramento
+static const int INTERVALO_ESPERA_MS = 200;
+
+// Valores padrão: os mesmos do manifesto do lote
+ConfiguracaoServico::ConfiguracaoServico()
+    : trabalhadores(0), maxGrafos(16), usarCache(true), calcularLimite(true) {}
+
+RequisicaoServico::RequisicaoServico()
+    : d(1), algoritmo("grasp"), alpha(0.5), iteracoes(100), bloco(10), semente(1), threads(1),
+      construcao(CONSTRUCAO_GRAU), buscaLocal(0), elite(0), componentes(false), podar(false),
+      enviarCores(true) {}
+
+// Uma execução na fila; o trabalhador entrega a resposta pela promise e o libera
+struct ServicoColoracao::Trabalho {
+    RequisicaoServico requisicao;
+    chrono::steady_clock::time_point chegada;
+    promise<string> resposta;
+};
+
+ServicoColoracao::ServicoColoracao(const ConfiguracaoServico& c)
+    : config(c), cache(c.maxGrafos, c.usarCache, c.calcularLimite), encerrando(false),
+      pedidoEncerrar(false), execucoes(0) {}
+
+// Converte um valor; false se for inválido
+template <typename T>
+static bool lerValor(const string& texto, T& destino) {
+    istringstream entrada(texto);
+    T x;
+    if (!(entrada >> x) || !entrada.eof()) {
+        return false;
+    }
+    destino = x;
+    return true;
+}
+
+static bool lerBooleano(const string& texto, bool& destino) {
+    int x;
+    if (!lerValor(texto, x)) {
+        return false;
+    }
+    destino = x != 0;
+    return true;
+}
+
+// Interpreta os pares "chave=valor"; os valores são conferidos aqui para
+// que uma requisição malformada não chegue aos algoritmos
+bool ServicoColoracao::lerRequisicao(const string& linha, RequisicaoServico& r, string& erro) {
+    r = RequisicaoServico();
+    istringstream entrada(linha);
+    string par;
+    while (entrada >> par) {
+        size_t igual = par.find('=');
+        if (igual == string::npos || igual == 0 || igual + 1 == par.size()) {
+            erro = "esperado \"chave=valor\": " + par;
+            return false;
+        }
+        string c = par.substr(0, igual);
+        string v = par.substr(igual + 1);
+        bool ok = true;
+        if (c == "instancia") {
+            r.instancia = v;
+        } else if (c == "d") {
+            ok = lerValor(v, r.d) && r.d >= 0;
+        } else if (c == "algoritmo") {
+            r.algoritmo = v;
+            ok = v == "guloso" || v == "dsatur" || v == "smallestlast" || v == "grasp" ||
+                 v == "reativo";
+        } else if (c == "alpha") {
+            ok = lerValor(v, r.alpha) && r.alpha >= 0 && r.alpha <= 1;
+        } else if (c == "iteracoes") {
+            ok = lerValor(v, r.iteracoes) && r.iteracoes > 0;
+        } else if (c == "bloco") {
+            ok = lerValor(v, r.bloco) && r.bloco > 0;
+        } else if (c == "semente") {
+            ok = lerValor(v, r.semente);
+        } else if (c == "threads") {
+            ok = lerValor(v, r.threads) && r.threads > 0;
+        } else if (c == "construcao") {
+            ok = ColoracaoDefeituosa::lerConstrucao(v, r.construcao);
+        } else if (c == "busca_local") {
+            ok = lerValor(v, r.buscaLocal) && r.buscaLocal >= 0;
+        } else if (c == "elite") {
+            ok = lerValor(v, r.elite) && r.elite >= 0;
+        } else if (c == "tempo") {
+            ok = lerValor(v, r.criterio.tempoLimite);
+        } else if (c == "alvo") {
+            ok = lerValor(v, r.criterio.alvoCores);
+        } else if (c == "estagnacao") {
+            ok = lerValor(v, r.criterio.iteracoesSemMelhora);
+        } else if (c == "componentes") {
+            ok = lerBooleano(v, r.componentes);
+        } else if (c == "podar") {
+            ok = lerBooleano(v, r.podar);
+        } else if (c == "cores") {
+            ok = lerBooleano(v, r.enviarCores);
+        } else {
+            erro = "chave desconhecida: " + c;
+            return false;
+        }
+        if (!ok) {
+            erro = "valor invalido para " + c + ": " + v;
+            return false;
+        }
+    }
+    if (r.instancia.empty()) {
+        erro = "requisicao sem instancia";
+        return false;
+    }
+    return true;
+}
+
+// Trabalhador: atende a fila até o encerramento, e então a esvazia
+void ServicoColoracao::trabalhar() {
+    while (true) {
+        Trabalho* t;
+        {
+            unique_lock<mutex> guarda(trava);
+            temTrabalho.wait(guarda, [this]() { return encerrando || !fila.empty(); });
+            if (fila.empty()) {
+                return;
+            }
+            t = fila.front();
+            fila.pop_front();
+        }
+        double espera = chrono::duration<double>(chrono::steady_clock::now() - t->chegada).count();
+        string resposta;
+        try {
+            resposta = executar(t->requisicao, espera);
+        } catch (const bad_alloc&) {
+            resposta = "erro memoria insuficiente\n\n";
+        }
+        t->resposta.set_value(resposta);
+        delete t;
+    }
+}
+
+// Uma execução, com a instância do cache; a resposta já vem formatada
+string ServicoColoracao::executar(const RequisicaoServico& r, double espera) {
+    bool acerto;
+    string erro;
+    shared_ptr<InstanciaCarregada> instancia = cache.obter(r.instancia, acerto, erro);
+    if (!instancia) {
+        return "erro " + erro + "\n\n";
+    }
+    int limite = (instancia->limite != nullptr) ? instancia->limite->limite(r.d) : 0;
+
+    ColoracaoDefeituosa coloracao(*instancia->grafo, r.d);
+    coloracao.setSemente(r.semente);
+    coloracao.setNumThreads(r.threads);
+    coloracao.setBuscaLocal(r.buscaLocal);
+    coloracao.setElite(r.elite);
+    coloracao.setCriterioParada(r.criterio);
+    coloracao.setLimiteInferior(limite);
+    coloracao.setConstrucao(r.construcao);
+    coloracao.setDecomposicao(r.componentes, r.podar);
+    coloracao.setSilencioso(true);
+
+    Solucao sol;
+    if (r.algoritmo == "guloso") {
+        sol = coloracao.algoritmoGuloso();
+    } else if (r.algoritmo == "dsatur") {
+        coloracao.setConstrucao(CONSTRUCAO_DSATUR);
+        sol = coloracao.algoritmoDSatur();
+    } else if (r.algoritmo == "smallestlast") {
+        coloracao.setConstrucao(CONSTRUCAO_SMALLEST_LAST);
+        sol = coloracao.algoritmoSmallestLast();
+    } else if (r.algoritmo == "grasp") {
+        sol = coloracao.algoritmoRandomizado(r.iteracoes, r.alpha);
+    } else {
+        sol = coloracao.algoritmoReativo(r.iteracoes, r.bloco);
+    }
+    execucoes++;
+
+    ostringstream texto;
+    texto << "ok numCores=" << sol.numCores << " deficiencias=" << sol.numDeficiencias
+          << " valida=" << (sol.valida ? 1 : 0) << " limite=" << limite
+          << " iteracoes=" << sol.iteracoesExecutadas
+          << " parada=" << (sol.criterioParada.empty() ? "-" : sol.criterioParada)
+          << " alphaMelhor=" << sol.alphaMelhor << fixed << setprecision(6)
+          << " tempo=" << sol.tempoExecucao << " espera=" << espera
+          << " carga=" << (acerto ? 0.0 : instancia->tempoCarga)
+          << " cache=" << (acerto ? "acerto" : "falta") << "\n";
+    if (r.enviarCores) {
+        texto << "cores";
+        for (int c : sol.cores) {
+            texto << ' ' << c;
+        }
+        texto << "\n";
+    }
+    texto << "\n";
+
+    ostringstream registro;
+    registro << "[servico] " << r.instancia << " d=" << r.d << " " << r.algoritmo
+             << " semente=" << r.semente << ": " << sol.numCores << " cores, " << fixed
+             << setprecision(3) << sol.tempoExecucao << " s (cache " << (acerto ? "acerto" : "falta")
+             << ")\n";
+    cerr << registro.str() << flush;
+    return texto.str();
+}
+
+// Comandos do serviço ou uma execução, enfileirada e aguardada
+string ServicoColoracao::responder(const string& linha) {
+    istringstream entrada(linha);
+    string comando, resto;
+    entrada >> comando;
+    bool sozinho = !(entrada >> resto);
+    if (sozinho && comando == "estado") {
+        size_t naFila;
+        {
+            lock_guard<mutex> guarda(trava);
+            naFila = fila.size();
+        }
+        ostringstream texto;
+        texto << "ok " << cache.descrever() << " fila=" << naFila << " trabalhadores="
+              << trabalhadores.size() << " execucoes=" << execucoes << "\n\n";
+        return texto.str();
+    }
+    if (sozinho && comando == "encerrar") {
+        pedidoEncerrar = true;
+        return "ok encerrando\n\n";
+    }
+
+    Trabalho* t = new Trabalho();
+    string erro;
+    if (!lerRequisicao(linha, t->requisicao, erro)) {
+        delete t;
+        return "erro " + erro + "\n\n";
+    }
+    t->chegada = chrono::steady_clock::now();
+    future<string> resposta = t->resposta.get_future();
+    {
+        lock_guard<mutex> guarda(trava);
+        fila.push_back(t);
+    }
+    temTrabalho.notify_one();
+    return resposta.get();
+}
+
+#ifndef _WIN32
+// SIGINT / SIGTERM: o laço de conexões encerra o serviço
+static volatile sig_atomic_t sinalRecebido = 0;
+
+static void tratarSinal(int) {
+    sinalRecebido = 1;
+}
+
+// Envia todos os bytes; false se a conexão foi fechada
+static bool enviarTudo(int descritor, const string& dados) {
+#ifdef MSG_NOSIGNAL
+    const int flags = MSG_NOSIGNAL;
+#else
+    const int flags = 0;
+#endif
+    size_t enviados = 0;
+    while (enviados < dados.size()) {
+        ssize_t n = send(descritor, dados.data() + enviados, dados.size() - enviados, flags);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        enviados += n;
+    }
+    return true;
+}
+
+// Outro processo já atende no socket?
+static bool servicoAtivo(const sockaddr_un& endereco) {
+    int sonda = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sonda < 0) {
+        return false;
+    }
+    bool ativo = connect(sonda, (const sockaddr*)&endereco, sizeof(endereco)) == 0;
+    close(sonda);
+    return ativo;
+}
+
+// Lê as requisições da conexão, uma por linha, e responde em ordem
+void ServicoColoracao::atenderConexao(int descritor) {
+    string pendente;
+    char buffer[4096];
+    while (true) {
+        size_t fim = pendente.find('\n');
+        if (fim == string::npos) {
+            if (pendente.size() > TAMANHO_MAXIMO_LINHA) {
+                enviarTudo(descritor, "erro linha longa demais\n\n");
+                break;
+            }
+            ssize_t lidos = recv(descritor, buffer, sizeof(buffer), 0);
+            if (lidos < 0 && errno == EINTR) {
+                continue;
+            }
+            if (lidos <= 0) {
+                break;
+            }
+            pendente.append(buffer, lidos);
+            continue;
+        }
+        string linha = pendente.substr(0, fim);
+        pendente.erase(0, fim + 1);
+        if (linha.find_first_not_of(" \t\r") == string::npos) {
+            continue;
+        }
+        if (!enviarTudo(descritor, responder(linha))) {
+            break;
+        }
+    }
+
+    // Fecha com a trava: o descritor não é reaproveitado por uma nova
+    // conexão antes de sair do conjunto
+    lock_guard<mutex> guarda(trava);
+    conexoes.erase(descritor);
+    close(descritor);
+    semConexoes.notify_all();
+}
+#endif
+
+// Laço de conexões e encerramento ordenado
+int ServicoColoracao::servir() {
+#ifdef _WIN32
+    cerr << "Modo servico indisponivel no Windows (requer sockets Unix)" << endl;
+    return 1;
+#else
+    sockaddr_un endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    if (config.socket.empty() || config.socket.size() >= sizeof(endereco.sun_path)) {
+        cerr << "Caminho de socket invalido: " << config.socket << endl;
+        return 1;
+    }
+    strcpy(endereco.sun_path, config.socket.c_str());
+
+    // Um socket que sobrou de um serviço encerrado é removido; um ativo ou
+    // um arquivo comum, não
+    struct stat info;
+    if (stat(config.socket.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            cerr << config.socket << " existe e nao e um socket" << endl;
+            return 1;
+        }
+        if (servicoAtivo(endereco)) {
+            cerr << "Ja existe um servico em " << config.socket << endl;
+            return 1;
+        }
+        unlink(config.socket.c_str());
+    }
+
+    int escuta = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (escuta < 0 || bind(escuta, (const sockaddr*)&endereco, sizeof(endereco)) != 0 ||
+        listen(escuta, SOMAXCONN) != 0) {
+        cerr << "Erro ao abrir o socket " << config.socket << ": " << strerror(errno) << endl;
+        if (escuta >= 0) {
+            close(escuta);
+        }
+        return 1;
+    }
+
+    struct sigaction acao;
+    memset(&acao, 0, sizeof(acao));
+    acao.sa_handler = tratarSinal;
+    sigemptyset(&acao.sa_mask);
+    sigaction(SIGINT, &acao, nullptr);
+    sigaction(SIGTERM, &acao, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    int numTrabalhadores = config.trabalhadores;
+    if (numTrabalhadores <= 0) {
+        numTrabalhadores = max(1, (int)thread::hardware_concurrency());
+    }
+    for (int i = 0; i < numTrabalhadores; i++) {
+        trabalhadores.push_back(thread(&ServicoColoracao::trabalhar, this));
+    }
+    cout << "Servico em " << config.socket << ": " << numTrabalhadores << " trabalhador(es), ate "
+         << max(config.maxGrafos, 1) << " instancias em memoria" << endl;
+
+    while (!sinalRecebido && !pedidoEncerrar) {
+        pollfd espera;
+        espera.fd = escuta;
+        espera.events = POLLIN;
+        espera.revents = 0;
+        int prontos = poll(&espera, 1, INTERVALO_ESPERA_MS);
+        if (prontos < 0 && errno != EINTR) {
+            cerr << "Erro ao aguardar conexoes: " << strerror(errno) << endl;
+            break;
+        }
+        if (prontos <= 0) {
+            continue;
+        }
+        int conexao = accept(escuta, nullptr, nullptr);
+        if (conexao < 0) {
+            continue;
+        }
+        {
+            lock_guard<mutex> guarda(trava);
+            conexoes.insert(conexao);
+        }
+        thread(&ServicoColoracao::atenderConexao, this, conexao).detach();
+    }
+    close(escuta);
+    unlink(config.socket.c_str());
+
+    // As conexões deixam de receber requisições, mas respondem às que já
+    // estão na fila; depois os trabalhadores terminam
+    {
+        unique_lock<mutex> guarda(trava);
+        for (int c : conexoes) {
+            shutdown(c, SHUT_RD);
+        }
+        semConexoes.wait(guarda, [this]() { return conexoes.empty(); });
+        encerrando = true;
+    }
+    temTrabalho.notify_all();
+    for (thread& t : trabalhadores) {
+        t.join();
+    }
+    cout << "Servico encerrado: " << execucoes << " execucoes; " << cache.descrever() << endl;
+    return 0;
+#endif
+}
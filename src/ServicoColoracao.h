@@ -0,0 +1,104 @@
+#ifndef SERVICO_COLORACAO_H
+#define SERVICO_COLORACAO_H
+
+#include "ColoracaoDefeituosa.h"
+#include "ControleParada.h"
+#include "CacheInstancias.h"
+#include <string>
+#include <deque>
+#include <set>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+using namespace std;
+
+// Configuração do modo serviço (--servico)
+struct ConfiguracaoServico {
+    string socket;          // caminho do socket Unix
+    int trabalhadores;      // execuções simultâneas (0 = núcleos)
+    int maxGrafos;          // instâncias mantidas no CacheInstancias
+    bool usarCache;         // cache binário <instancia>.csr na leitura
+    bool calcularLimite;    // limite inferior de cada instância carregada
+
+    ConfiguracaoServico();
+};
+
+// Uma requisição: uma linha de pares "chave=valor" separados por espaços,
+// com as chaves do manifesto do lote (instancia, d, algoritmo, alpha,
+// iteracoes, bloco, semente, threads, construcao, busca_local, elite,
+// tempo, alvo, estagnacao, componentes, podar) e cores=0 para não devolver
+// a cor de cada vértice
+struct RequisicaoServico {
+    string instancia;
+    int d;
+    string algoritmo;       // guloso, dsatur, smallestlast, grasp, reativo
+    double alpha;
+    int iteracoes;
+    int bloco;
+    unsigned int semente;
+    int threads;
+    Construcao construcao;
+    int buscaLocal;
+    int elite;
+    CriterioParada criterio;
+    bool componentes;
+    bool podar;
+    bool enviarCores;
+
+    RequisicaoServico();
+};
+
+// Modo serviço: processo de longa duração que atende requisições por um
+// socket Unix, evitando a partida do programa e a leitura da instância a
+// cada execução. As instâncias lidas ficam num CacheInstancias (LRU por
+// caminho, validado pela data de modificação) e as execuções, numa fila
+// atendida por um conjunto fixo de trabalhadores. Cada conexão é atendida
+// por uma thread que lê as requisições, uma por linha, e escreve as
+// respostas na mesma ordem; clientes diferentes são atendidos em paralelo.
+//
+// Resposta: "ok chave=valor ..." com o resumo da Solucao, seguida de
+// "cores c0 c1 ..." (a menos que cores=0), ou "erro <motivo>"; uma linha
+// vazia encerra cada resposta. Além das execuções, "estado" resume o cache
+// e a fila, e "encerrar" termina o serviço depois das execuções pendentes
+// (assim como SIGINT e SIGTERM).
+class ServicoColoracao {
+private:
+    struct Trabalho;
+
+    ConfiguracaoServico config;
+    CacheInstancias cache;
+
+    mutex trava;
+    condition_variable temTrabalho;
+    condition_variable semConexoes;
+    deque<Trabalho*> fila;
+    vector<thread> trabalhadores;
+    set<int> conexoes;      // descritores das conexões abertas
+    bool encerrando;        // trabalhadores terminam ao esvaziar a fila
+    atomic<bool> pedidoEncerrar;
+    atomic<long long> execucoes;
+
+    void trabalhar();
+    void atenderConexao(int descritor);
+
+    // Resposta a uma linha recebida (espera a execução, se for o caso)
+    string responder(const string& linha);
+    string executar(const RequisicaoServico& r, double espera);
+
+    ServicoColoracao(const ServicoColoracao&);
+    ServicoColoracao& operator=(const ServicoColoracao&);
+
+public:
+    ServicoColoracao(const ConfiguracaoServico& c);
+
+    // Atende até "encerrar" ou um sinal; retorna o código de saída do programa
+    int servir();
+
+    // Interpreta uma requisição; em caso de erro, descreve-o em erro e retorna false
+    static bool lerRequisicao(const string& linha, RequisicaoServico& r, string& erro);
+};
+
+#endif
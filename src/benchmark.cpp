@@ -0,0 +1,430 @@
+// Benchmark dos algoritmos de coloração defeituosa sobre grafos sintéticos.
+// Para cada gerador e algoritmo: aquecimento, repetições cronometradas e
+// relatório (CSV ou JSON) com mediana, p95, vazão e pico de memória.
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <atomic>
+#include <new>
+#include "Grafo.h"
+#include "ColoracaoDefeituosa.h"
+#include "GeradorGrafos.h"
+#include "MedidorMemoria.h"
+
+using namespace std;
+
+// Contador global de alocações: as versões substituíveis de operator new
+// deste programa contam cada chamada (new[] delega a operator new)
+static atomic<long long> totalAlocacoes(0);
+
+void* operator new(size_t tamanho) {
+    totalAlocacoes.fetch_add(1, memory_order_relaxed);
+    void* p = malloc(tamanho == 0 ? 1 : tamanho);
+    if (p == nullptr) {
+        throw bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+struct ConfiguracaoBenchmark {
+    int n;
+    long long m;
+    unsigned int semente;
+    int d;
+    int repeticoes;
+    int aquecimento;
+    int iteracoes;
+    double alpha;
+    int tamBloco;
+    int threads;
+    int buscaLocal;
+    int elite;              // conjunto elite e religação de caminhos (0 = desligado)
+    Construcao construcao;  // ordem dos vértices no GRASP / Reativo
+    vector<string> geradores;
+    vector<string> algoritmos;
+    vector<Reordenacao> reordenacoes; // renumerações dos vértices comparadas
+    string saida;     // vazio = saída padrão
+    string formato;   // csv | json
+    bool medirAlocacoes;
+    bool matrizBits;  // permite o backend denso nos grafos que o admitem
+};
+
+struct ResultadoBenchmark {
+    string gerador;
+    string algoritmo;
+    string backend;   // listas | bits
+    string reordenacao;
+    double tempoReordenacao;  // ordem + reconstrução do CSR, em segundos
+    int n;
+    long long m;
+    int iteracoes;
+    double tempoGeracao;
+    double mediana;
+    double p95;
+    double media;
+    double minimo;
+    double iteracoesPorSegundo;
+    double arestasPorSegundo;
+    long picoRSSKB;
+    int numCores;
+    int numDeficiencias;
+    double alocacoesPorIteracao;  // alocações por iteração em regime (-1 = não medido)
+};
+
+// Percentil por posto mais próximo de tempos já ordenados
+double percentil(const vector<double>& ordenados, double q) {
+    if (ordenados.empty()) {
+        return 0.0;
+    }
+    size_t posto = (size_t)(q * ordenados.size() + 0.999999);
+    posto = max<size_t>(posto, 1);
+    return ordenados[min(posto, ordenados.size()) - 1];
+}
+
+// Separa "a,b,c"
+vector<string> separar(const string& texto) {
+    vector<string> partes;
+    stringstream ss(texto);
+    string parte;
+    while (getline(ss, parte, ',')) {
+        if (!parte.empty()) {
+            partes.push_back(parte);
+        }
+    }
+    return partes;
+}
+
+void imprimirUso() {
+    cout << "Uso: ./benchmark [opcoes]" << endl;
+    cout << "  --n <N>               vertices (padrao 20000)" << endl;
+    cout << "  --m <M>               arestas aproximadas (padrao 100000)" << endl;
+    cout << "  --semente <S>         semente dos geradores e algoritmos (padrao 1)" << endl;
+    cout << "  --d <D>               deficiencias por vertice (padrao 1)" << endl;
+    cout << "  --repeticoes <R>      execucoes cronometradas (padrao 5)" << endl;
+    cout << "  --aquecimento <W>     execucoes descartadas (padrao 1)" << endl;
+    cout << "  --iteracoes <I>       iteracoes do GRASP / Reativo (padrao 20)" << endl;
+    cout << "  --alpha <A>           alpha do GRASP (padrao 0.5)" << endl;
+    cout << "  --bloco <B>           tamanho do bloco do Reativo (padrao 5)" << endl;
+    cout << "  --threads <T>         threads do GRASP / Reativo (padrao 1)" << endl;
+    cout << "  --busca-local <K>     iteracoes tabu da busca local (padrao 0)" << endl;
+    cout << "  --elite <K>           elite de K solucoes e religacao de caminhos (padrao 0)" << endl;
+    cout << "  --geradores <lista>   er,rgg,powerlaw,kpartite" << endl;
+    cout << "  --algoritmos <lista>  guloso,dsatur,smallestlast,grasp,reativo" << endl;
+    cout << "                        (padrao guloso,grasp,reativo)" << endl;
+    cout << "  --construcao <c>      grau|dsatur|smallestlast no GRASP / Reativo" << endl;
+    cout << "  --reordenacoes <lista> nenhuma,rcm,bfs,grau: renumeracoes comparadas (padrao nenhuma)" << endl;
+    cout << "  --formato <csv|json>  formato do relatorio (padrao csv)" << endl;
+    cout << "  --saida <arquivo>     grava o relatorio no arquivo (padrao: tela)" << endl;
+    cout << "  --alocacoes <0|1>     mede alocacoes por iteracao em regime (padrao 1)" << endl;
+    cout << "  --matriz-bits <0|1>   backend denso automatico em grafos densos (padrao 1)" << endl;
+}
+
+// Construções determinísticas (uma única iteração)
+bool construtivo(const string& algoritmo) {
+    return algoritmo == "guloso" || algoritmo == "dsatur" || algoritmo == "smallestlast";
+}
+
+// Executa um algoritmo uma vez
+Solucao executar(ColoracaoDefeituosa& coloracao, const string& algoritmo,
+                 const ConfiguracaoBenchmark& cfg, int iteracoes) {
+    if (algoritmo == "guloso") {
+        return coloracao.algoritmoGuloso();
+    } else if (algoritmo == "dsatur") {
+        return coloracao.algoritmoDSatur();
+    } else if (algoritmo == "smallestlast") {
+        return coloracao.algoritmoSmallestLast();
+    } else if (algoritmo == "grasp") {
+        return coloracao.algoritmoRandomizado(iteracoes, cfg.alpha);
+    }
+    return coloracao.algoritmoReativo(iteracoes, cfg.tamBloco);
+}
+
+// Alocações de uma execução completa com a semente informada
+long long contarAlocacoes(const Grafo& g, const string& algoritmo, const ConfiguracaoBenchmark& cfg,
+                          int iteracoes, Reordenacao reordenacao, const vector<int>& rotulos) {
+    long long antes = totalAlocacoes.load();
+    {
+        ColoracaoDefeituosa coloracao(g, cfg.d);
+        coloracao.setReordenacao(reordenacao, rotulos);
+        coloracao.setSemente(cfg.semente);
+        coloracao.setNumThreads(cfg.threads);
+        coloracao.setBuscaLocal(cfg.buscaLocal);
+        coloracao.setElite(cfg.elite);
+        coloracao.setConstrucao(cfg.construcao);
+        coloracao.setSilencioso(true);
+        executar(coloracao, algoritmo, cfg, iteracoes);
+    }
+    return totalAlocacoes.load() - antes;
+}
+
+// Alocações por iteração em regime: as primeiras I iterações de uma execução
+// com 2I iterações repetem a execução com I (mesma semente), logo a diferença
+// entre as duas contagens vem apenas das I iterações adicionais
+double alocacoesPorIteracao(const Grafo& g, const string& algoritmo, const ConfiguracaoBenchmark& cfg,
+                            Reordenacao reordenacao, const vector<int>& rotulos) {
+    int base = max(cfg.iteracoes, cfg.tamBloco);
+    long long simples = contarAlocacoes(g, algoritmo, cfg, base, reordenacao, rotulos);
+    long long dobro = contarAlocacoes(g, algoritmo, cfg, 2 * base, reordenacao, rotulos);
+    return (double)(dobro - simples) / base;
+}
+
+void escreverCSV(ostream& saida, const vector<ResultadoBenchmark>& resultados) {
+    saida << "Gerador,Algoritmo,Backend,Reordenacao,N,M,Iteracoes,TempoGeracao(s),TempoReordenacao(s),"
+          << "Mediana(s),P95(s),Media(s),"
+          << "Minimo(s),IteracoesPorSegundo,ArestasPorSegundo,PicoRSS(KB),NumCores,NumDeficiencias,"
+          << "AlocacoesPorIteracao\n";
+    for (const ResultadoBenchmark& r : resultados) {
+        saida << r.gerador << "," << r.algoritmo << "," << r.backend << "," << r.reordenacao << ","
+              << r.n << "," << r.m << ","
+              << r.iteracoes << "," << fixed << setprecision(6) << r.tempoGeracao << ","
+              << r.tempoReordenacao << ","
+              << r.mediana << "," << r.p95 << "," << r.media << "," << r.minimo << ","
+              << setprecision(2) << r.iteracoesPorSegundo << "," << r.arestasPorSegundo << ","
+              << r.picoRSSKB << "," << r.numCores << "," << r.numDeficiencias << ","
+              << r.alocacoesPorIteracao << "\n";
+    }
+}
+
+void escreverJSON(ostream& saida, const vector<ResultadoBenchmark>& resultados) {
+    saida << "[\n";
+    for (size_t i = 0; i < resultados.size(); i++) {
+        const ResultadoBenchmark& r = resultados[i];
+        saida << "  {\"gerador\": \"" << r.gerador << "\", \"algoritmo\": \"" << r.algoritmo
+              << "\", \"backend\": \"" << r.backend << "\", \"reordenacao\": \"" << r.reordenacao
+              << "\", \"n\": " << r.n << ", \"m\": " << r.m << ", \"iteracoes\": " << r.iteracoes
+              << fixed << setprecision(6)
+              << ", \"tempo_geracao_s\": " << r.tempoGeracao
+              << ", \"tempo_reordenacao_s\": " << r.tempoReordenacao
+              << ", \"mediana_s\": " << r.mediana << ", \"p95_s\": " << r.p95
+              << ", \"media_s\": " << r.media << ", \"minimo_s\": " << r.minimo
+              << setprecision(2)
+              << ", \"iteracoes_por_segundo\": " << r.iteracoesPorSegundo
+              << ", \"arestas_por_segundo\": " << r.arestasPorSegundo
+              << ", \"pico_rss_kb\": " << r.picoRSSKB << ", \"num_cores\": " << r.numCores
+              << ", \"num_deficiencias\": " << r.numDeficiencias
+              << ", \"alocacoes_por_iteracao\": " << r.alocacoesPorIteracao << "}"
+              << (i + 1 < resultados.size() ? "," : "") << "\n";
+    }
+    saida << "]\n";
+}
+
+int main(int argc, char* argv[]) {
+    ConfiguracaoBenchmark cfg;
+    cfg.n = 20000;
+    cfg.m = 100000;
+    cfg.semente = 1;
+    cfg.d = 1;
+    cfg.repeticoes = 5;
+    cfg.aquecimento = 1;
+    cfg.iteracoes = 20;
+    cfg.alpha = 0.5;
+    cfg.tamBloco = 5;
+    cfg.threads = 1;
+    cfg.buscaLocal = 0;
+    cfg.elite = 0;
+    cfg.construcao = CONSTRUCAO_GRAU;
+    cfg.geradores = separar("er,rgg,powerlaw,kpartite");
+    cfg.algoritmos = separar("guloso,grasp,reativo");
+    cfg.reordenacoes.push_back(REORDENACAO_NENHUMA);
+    cfg.formato = "csv";
+    cfg.medirAlocacoes = true;
+    cfg.matrizBits = true;
+
+    for (int i = 1; i < argc; i++) {
+        string opcao = argv[i];
+        if (opcao == "--ajuda" || opcao == "-h") {
+            imprimirUso();
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            cerr << "Valor ausente para " << opcao << endl;
+            imprimirUso();
+            return 1;
+        }
+        string valor = argv[++i];
+
+        if (opcao == "--n") cfg.n = atoi(valor.c_str());
+        else if (opcao == "--m") cfg.m = atoll(valor.c_str());
+        else if (opcao == "--semente") cfg.semente = strtoul(valor.c_str(), nullptr, 10);
+        else if (opcao == "--d") cfg.d = atoi(valor.c_str());
+        else if (opcao == "--repeticoes") cfg.repeticoes = max(1, atoi(valor.c_str()));
+        else if (opcao == "--aquecimento") cfg.aquecimento = max(0, atoi(valor.c_str()));
+        else if (opcao == "--iteracoes") cfg.iteracoes = max(1, atoi(valor.c_str()));
+        else if (opcao == "--alpha") cfg.alpha = atof(valor.c_str());
+        else if (opcao == "--bloco") cfg.tamBloco = max(1, atoi(valor.c_str()));
+        else if (opcao == "--threads") cfg.threads = max(1, atoi(valor.c_str()));
+        else if (opcao == "--busca-local") cfg.buscaLocal = atoi(valor.c_str());
+        else if (opcao == "--elite") cfg.elite = max(0, atoi(valor.c_str()));
+        else if (opcao == "--construcao") {
+            if (!ColoracaoDefeituosa::lerConstrucao(valor, cfg.construcao)) {
+                cerr << "Construcao desconhecida: " << valor << endl;
+                return 1;
+            }
+        }
+        else if (opcao == "--reordenacoes") {
+            cfg.reordenacoes.clear();
+            for (const string& nome : separar(valor)) {
+                Reordenacao r;
+                if (!Grafo::lerReordenacao(nome, r)) {
+                    cerr << "Reordenacao desconhecida: " << nome << endl;
+                    return 1;
+                }
+                cfg.reordenacoes.push_back(r);
+            }
+        }
+        else if (opcao == "--geradores") cfg.geradores = separar(valor);
+        else if (opcao == "--algoritmos") cfg.algoritmos = separar(valor);
+        else if (opcao == "--formato") cfg.formato = valor;
+        else if (opcao == "--saida") cfg.saida = valor;
+        else if (opcao == "--alocacoes") cfg.medirAlocacoes = atoi(valor.c_str()) != 0;
+        else if (opcao == "--matriz-bits") cfg.matrizBits = atoi(valor.c_str()) != 0;
+        else {
+            cerr << "Opcao desconhecida: " << opcao << endl;
+            imprimirUso();
+            return 1;
+        }
+    }
+
+    vector<ResultadoBenchmark> resultados;
+
+    for (const string& tipo : cfg.geradores) {
+        auto inicioGeracao = chrono::steady_clock::now();
+        Grafo* g = GeradorGrafos::gerar(tipo, cfg.n, cfg.m, cfg.semente);
+        auto fimGeracao = chrono::steady_clock::now();
+        if (g == nullptr) {
+            cerr << "Gerador desconhecido: " << tipo << endl;
+            continue;
+        }
+        double tempoGeracao = chrono::duration<double>(fimGeracao - inicioGeracao).count();
+        if (!cfg.matrizBits) {
+            g->usarMatrizBits(false);
+        }
+        cerr << "[" << tipo << "] " << g->getNumVertices() << " vertices, "
+             << g->getNumArestas() << " arestas"
+             << (g->temMatrizBits() ? " (matriz de bits)" : "") << endl;
+
+        for (Reordenacao reordenacao : cfg.reordenacoes) {
+            // Grafo renumerado (o original quando não há reordenação)
+            Grafo* gr = g;
+            vector<int> rotulos;
+            double tempoReordenacao = 0.0;
+            if (reordenacao != REORDENACAO_NENHUMA) {
+                auto inicioReordenacao = chrono::steady_clock::now();
+                rotulos = g->ordemReordenacao(reordenacao);
+                gr = g->reordenar(rotulos);
+                tempoReordenacao = chrono::duration<double>(chrono::steady_clock::now() -
+                                                            inicioReordenacao).count();
+                if (!cfg.matrizBits) {
+                    gr->usarMatrizBits(false);
+                }
+                cerr << "  reordenacao " << Grafo::nomeReordenacao(reordenacao) << ": " << fixed
+                     << setprecision(4) << tempoReordenacao << " s" << endl;
+            }
+
+            for (const string& algoritmo : cfg.algoritmos) {
+                if (!construtivo(algoritmo) && algoritmo != "grasp" && algoritmo != "reativo") {
+                    cerr << "Algoritmo desconhecido: " << algoritmo << endl;
+                    continue;
+                }
+
+                vector<double> tempos;
+                Solucao ultima;
+                for (int rep = 0; rep < cfg.aquecimento + cfg.repeticoes; rep++) {
+                    ColoracaoDefeituosa coloracao(*gr, cfg.d);
+                    coloracao.setReordenacao(reordenacao, rotulos);
+                    coloracao.setSemente(cfg.semente + rep);
+                    coloracao.setNumThreads(cfg.threads);
+                    coloracao.setBuscaLocal(cfg.buscaLocal);
+                    coloracao.setElite(cfg.elite);
+                    coloracao.setConstrucao(cfg.construcao);
+                    coloracao.setSilencioso(true);
+
+                    auto inicio = chrono::steady_clock::now();
+                    ultima = executar(coloracao, algoritmo, cfg, cfg.iteracoes);
+                    auto fim = chrono::steady_clock::now();
+
+                    if (rep >= cfg.aquecimento) {
+                        tempos.push_back(chrono::duration<double>(fim - inicio).count());
+                    }
+                }
+                sort(tempos.begin(), tempos.end());
+
+                ResultadoBenchmark r;
+                r.gerador = tipo;
+                r.algoritmo = algoritmo;
+                r.reordenacao = Grafo::nomeReordenacao(reordenacao);
+                r.tempoReordenacao = tempoReordenacao;
+                r.backend = gr->temMatrizBits() ? "bits" : "listas";
+                r.n = g->getNumVertices();
+                r.m = g->getNumArestas();
+                r.iteracoes = construtivo(algoritmo) ? 1 : cfg.iteracoes;
+                r.tempoGeracao = tempoGeracao;
+                r.mediana = percentil(tempos, 0.5);
+                r.p95 = percentil(tempos, 0.95);
+                r.minimo = tempos.front();
+                r.media = 0.0;
+                for (double t : tempos) {
+                    r.media += t;
+                }
+                r.media /= tempos.size();
+                r.iteracoesPorSegundo = (r.mediana > 0) ? r.iteracoes / r.mediana : 0.0;
+                r.arestasPorSegundo = (r.mediana > 0) ? (double)r.m * r.iteracoes / r.mediana : 0.0;
+                r.picoRSSKB = MedidorMemoria::picoResidenteKB();
+                r.numCores = ultima.numCores;
+                r.numDeficiencias = ultima.numDeficiencias;
+                r.alocacoesPorIteracao = -1;
+                if (cfg.medirAlocacoes && !construtivo(algoritmo)) {
+                    r.alocacoesPorIteracao = alocacoesPorIteracao(*gr, algoritmo, cfg, reordenacao, rotulos);
+                }
+                resultados.push_back(r);
+
+                cerr << "  " << algoritmo << " (" << r.reordenacao << "): mediana " << fixed << setprecision(4) << r.mediana
+                     << " s, p95 " << r.p95 << " s, " << r.numCores << " cores";
+                if (r.alocacoesPorIteracao > 0) {
+                    cerr << ", " << setprecision(2) << r.alocacoesPorIteracao
+                         << " alocacoes por iteracao em regime";
+                }
+                cerr << endl;
+            }
+            if (gr != g) {
+                delete gr;
+            }
+        }
+        delete g;
+    }
+
+    ofstream arquivo;
+    if (!cfg.saida.empty()) {
+        arquivo.open(cfg.saida);
+        if (!arquivo.is_open()) {
+            cerr << "Erro ao criar arquivo: " << cfg.saida << endl;
+            return 1;
+        }
+    }
+    ostream& saida = cfg.saida.empty() ? cout : arquivo;
+
+    if (cfg.formato == "json") {
+        escreverJSON(saida, resultados);
+    } else {
+        escreverCSV(saida, resultados);
+    }
+
+    if (!cfg.saida.empty()) {
+        cerr << "Relatorio salvo em " << cfg.saida << endl;
+    }
+    return 0;
+}
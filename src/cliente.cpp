@@ -0,0 +1,109 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Cliente de teste do modo serviço (./coloracao --servico <socket>): envia
+// as requisições, uma por linha, e imprime as respostas na ordem.
+// Sem requisições na linha de comando, lê uma por linha da entrada padrão.
+
+// Envia todos os bytes; false se a conexão foi fechada
+static bool enviarTudo(int descritor, const string& dados) {
+    size_t enviados = 0;
+    while (enviados < dados.size()) {
+        ssize_t n = send(descritor, dados.data() + enviados, dados.size() - enviados, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        enviados += n;
+    }
+    return true;
+}
+
+// Uma resposta: linhas até a linha vazia (não incluída); false se a
+// conexão fechou antes
+static bool lerResposta(int descritor, string& pendente, string& resposta) {
+    char buffer[65536];
+    while (true) {
+        size_t fim = pendente.find("\n\n");
+        if (fim != string::npos) {
+            resposta = pendente.substr(0, fim + 1);
+            pendente.erase(0, fim + 2);
+            return true;
+        }
+        ssize_t lidos = recv(descritor, buffer, sizeof(buffer), 0);
+        if (lidos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (lidos <= 0) {
+            return false;
+        }
+        pendente.append(buffer, lidos);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Uso: ./cliente <socket> [\"requisicao\" ...]" << endl;
+        cout << "  ./cliente /tmp/coloracao.sock \"instancia=grafo.txt d=1 algoritmo=grasp "
+                "alpha=0.5 iteracoes=100 semente=42\"" << endl;
+        cout << "  ./cliente /tmp/coloracao.sock estado" << endl;
+        cout << "  ./cliente /tmp/coloracao.sock < requisicoes.txt" << endl;
+        return 1;
+    }
+
+    sockaddr_un endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    string caminho = argv[1];
+    if (caminho.size() >= sizeof(endereco.sun_path)) {
+        cerr << "Caminho de socket invalido: " << caminho << endl;
+        return 1;
+    }
+    strcpy(endereco.sun_path, caminho.c_str());
+    int descritor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (descritor < 0 || connect(descritor, (const sockaddr*)&endereco, sizeof(endereco)) != 0) {
+        cerr << "Erro ao conectar a " << caminho << ": " << strerror(errno) << endl;
+        return 1;
+    }
+
+    vector<string> requisicoes(argv + 2, argv + argc);
+    bool daEntrada = requisicoes.empty();
+    int erros = 0;
+    string pendente, linha, resposta;
+    for (size_t i = 0; ; i++) {
+        if (daEntrada) {
+            if (!getline(cin, linha)) {
+                break;
+            }
+        } else if (i < requisicoes.size()) {
+            linha = requisicoes[i];
+        } else {
+            break;
+        }
+        // O serviço ignora linhas vazias, sem responder
+        if (linha.find_first_not_of(" \t\r") == string::npos) {
+            continue;
+        }
+        if (!enviarTudo(descritor, linha + "\n") || !lerResposta(descritor, pendente, resposta)) {
+            cerr << "Conexao encerrada pelo servico" << endl;
+            close(descritor);
+            return 1;
+        }
+        cout << resposta << flush;
+        if (resposta.compare(0, 4, "erro") == 0) {
+            erros++;
+        }
+    }
+    close(descritor);
+    return erros > 0 ? 1 : 0;
+}
@@ -7,9 +7,9 @@ Write-Host "=== Compilando Coloracao Defeituosa ===" -ForegroundColor Green
 $env:Path += ";C:\msys64\mingw64\bin"
 
 $compiler = "g++"
-$flags = "-std=c++11 -O3 -Wall"
+$flags = "-std=c++11 -O3 -Wall -pthread"
 $output = "coloracao.exe"
-$sources = "main.cpp Grafo.cpp ColoracaoDefeituosa.cpp"
+$sources = "main.cpp Grafo.cpp EscritorAssincrono.cpp KernelBits.cpp ArquivoMapeado.cpp LeitorInstancia.cpp CacheGrafo.cpp MedidorMemoria.cpp GeradorAleatorio.cpp EstadoColoracao.cpp FilaCandidatos.cpp FilaSaturacao.cpp BuscaLocal.cpp CasamentoCores.cpp PoolElite.cpp ReligacaoCaminhos.cpp LimiteInferior.cpp Decomposicao.cpp ControleParada.cpp Barreira.cpp Instrumentacao.cpp ColoracaoDefeituosa.cpp PoolTarefas.cpp EscritorResultados.cpp ExecutorLote.cpp CacheInstancias.cpp ServicoColoracao.cpp"
 
 # Verifica se g++ está disponível
 if (!(Get-Command $compiler -ErrorAction SilentlyContinue)) {
@@ -1,17 +1,31 @@
 #include <iostream>
+#include <sstream>
+#include <limits>
 #include <cstdlib>
 #include <ctime>
+#include <vector>
+#include <string>
+#include <chrono>
 #include "Grafo.h"
 #include "ColoracaoDefeituosa.h"
+#include "LeitorInstancia.h"
+#include "KernelBits.h"
+#include "CacheGrafo.h"
+#include "MedidorMemoria.h"
+#include "ExecutorLote.h"
+#include "LimiteInferior.h"
+#include "ServicoColoracao.h"
 
 using namespace std;
 
 void imprimirUso() {
     cout << "Uso: ./programa <instancia> <d> <algoritmo> [parametros]" << endl;
+    cout << "     ./programa --lote <manifesto>" << endl;
+    cout << "     ./programa --servico <socket> [--trabalhadores <N>] [--max-grafos <K>]" << endl;
     cout << "\nParametros:" << endl;
     cout << "  <instancia> : caminho para arquivo de instancia do grafo" << endl;
     cout << "  <d>         : parametro d (numero maximo de deficiencias por vertice)" << endl;
-    cout << "  <algoritmo> : guloso | grasp | reativo" << endl;
+    cout << "  <algoritmo> : guloso | dsatur | smallestlast | grasp | reativo" << endl;
     cout << "\nParametros adicionais:" << endl;
     cout << "  Para GRASP:" << endl;
     cout << "    <alpha> <numIteracoes> [semente]" << endl;
@@ -19,10 +33,108 @@ void imprimirUso() {
     cout << "    <numIteracoes> <tamanhoBloco> [semente]" << endl;
     cout << "\nExemplos:" << endl;
     cout << "  ./programa grafo.txt 1 guloso" << endl;
+    cout << "  ./programa grafo.txt 1 dsatur" << endl;
     cout << "  ./programa grafo.txt 1 grasp 0.5 100" << endl;
     cout << "  ./programa grafo.txt 1 grasp 0.5 100 12345" << endl;
     cout << "  ./programa grafo.txt 1 reativo 100 10" << endl;
     cout << "  ./programa grafo.txt 1 reativo 100 10 67890" << endl;
+    cout << "\nOpcoes:" << endl;
+    cout << "  --threads <N> : executa as iteracoes do GRASP / Reativo em N threads" << endl;
+    cout << "  --sem-cache   : ignora (e nao grava) o cache binario <instancia>.csr" << endl;
+    cout << "  --busca-local <K> : aplica busca local (K iteracoes tabu por tentativa)" << endl;
+    cout << "  --elite <K>   : GRASP / Reativo guardam uma elite de K solucoes e religam seus pares" << endl;
+    cout << "  --sem-bits    : nao usa a matriz de bits mesmo em grafos densos" << endl;
+    cout << "  --tempo <S>   : GRASP / Reativo param apos S segundos" << endl;
+    cout << "  --alvo <K>    : GRASP / Reativo param ao atingir K cores" << endl;
+    cout << "  --limite-inferior <L> : limite inferior conhecido; para ao atingi-lo" << endl;
+    cout << "  --sem-limite  : nao calcula o limite inferior (clique, densidade, grau)" << endl;
+    cout << "  --componentes : resolve cada componente conexo a parte (em paralelo com --threads)" << endl;
+    cout << "  --podar       : colore por ultimo os vertices de grau residual abaixo do limite inferior" << endl;
+    cout << "  --estagnacao <K> : para apos K iteracoes sem melhora" << endl;
+    cout << "  --externo     : modo semi-externo (arestas no disco, memoria O(n))" << endl;
+    cout << "  --construcao <grau|dsatur|smallestlast> : ordem dos vertices no GRASP / Reativo" << endl;
+    cout << "  --reordenar <nenhuma|rcm|bfs|grau> : renumera os vertices antes de colorir" << endl;
+    cout << "  --lote <manifesto> : executa o experimento descrito no manifesto" << endl;
+    cout << "  --servico <socket> : atende requisicoes num socket Unix (ver ./cliente)" << endl;
+    cout << "    --trabalhadores <N> : execucoes simultaneas do servico (padrao: nucleos)" << endl;
+    cout << "    --max-grafos <K>    : instancias mantidas em memoria pelo servico (padrao: 16)" << endl;
+    cout << "  --silencioso  : nao lista as cores por vertice nem as estatisticas dos alphas" << endl;
+    cout << "  --salvar-solucao <arquivo> : grava a solucao em formato binario compacto" << endl;
+    cout << "\n  ./programa grafo.txt 1 grasp 0.5 10000 12345 --threads 8" << endl;
+    cout << "  ./programa grafo.txt 1 reativo 1000000 50 --tempo 30 --estagnacao 5000" << endl;
+}
+
+// Memoria do processo no modo semi-externo (chamada com a solucao ainda viva)
+void imprimirMemoria() {
+    cout << "Memoria: pico residente " << MedidorMemoria::picoResidenteKB()
+         << " KB (inclui paginas do cache mapeado), anonima "
+         << MedidorMemoria::anonimaKB() << " KB" << endl;
+}
+
+// Grava a solucao em binario, se --salvar-solucao foi informado
+void salvarSolucao(ColoracaoDefeituosa& coloracao, const Solucao& sol, const string& arquivo) {
+    if (!arquivo.empty()) {
+        coloracao.salvarSolucaoBinaria(sol, arquivo);
+    }
+}
+
+// Remove a opcao sem valor "<nome>" da lista de argumentos.
+// Retorna true se a opcao foi encontrada.
+bool extrairFlag(vector<string>& args, const string& nome) {
+    for (size_t i = 0; i < args.size(); i++) {
+        if (args[i] == nome) {
+            args.erase(args.begin() + i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Remove a opcao "<nome> <valor>" da lista de argumentos.
+// Retorna true se a opcao foi encontrada.
+bool extrairOpcao(vector<string>& args, const string& nome, string& valor) {
+    for (size_t i = 0; i + 1 < args.size(); i++) {
+        if (args[i] == nome) {
+            valor = args[i + 1];
+            args.erase(args.begin() + i, args.begin() + i + 2);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Converte um valor numérico em [minimo, maximo], com a mesma regra do
+// manifesto do lote e das requisições do serviço (texto inteiro, sem sobras)
+template <typename T>
+bool lerNumero(const string& nome, const string& texto, T minimo, T maximo, T& destino) {
+    istringstream entrada(texto);
+    T x;
+    if (!(entrada >> x) || !entrada.eof() || x < minimo || x > maximo) {
+        cout << "Valor invalido para " << nome << ": " << texto << endl;
+        return false;
+    }
+    destino = x;
+    return true;
+}
+
+// Remove a opcao "<nome> <valor>" e converte o valor (o destino fica
+// inalterado se a opcao nao foi informada). Retorna false se o valor for invalido.
+template <typename T>
+bool extrairNumero(vector<string>& args, const string& nome, T minimo, T maximo, T& destino) {
+    string valor;
+    return !extrairOpcao(args, nome, valor) || lerNumero(nome, valor, minimo, maximo, destino);
+}
+
+// Depois de extraidas as opcoes conhecidas, nenhum "--..." pode sobrar:
+// uma opcao desconhecida (ou sem valor) acabaria num parametro posicional
+bool semOpcoesRestantes(const vector<string>& args) {
+    for (size_t i = 1; i < args.size(); i++) {
+        if (args[i].compare(0, 2, "--") == 0) {
+            cout << "Opcao desconhecida ou sem valor: " << args[i] << endl;
+            return false;
+        }
+    }
+    return true;
 }
 
 int main(int argc, char* argv[]) {
@@ -41,6 +153,7 @@ int main(int argc, char* argv[]) {
         g.adicionarAresta(3, 4);
         g.adicionarAresta(3, 5);
         g.adicionarAresta(4, 5);
+        g.congelar();
         
         cout << "Grafo:" << endl;
         g.imprimir();
@@ -50,10 +163,10 @@ int main(int argc, char* argv[]) {
         
         // Inicializa semente
         unsigned int semente = time(0);
-        srand(semente);
         cout << "Semente de randomizacao: " << semente << endl;
         
         ColoracaoDefeituosa coloracao(g, d);
+        coloracao.setSemente(semente);
         
         int opcao;
         do {
@@ -124,18 +237,115 @@ int main(int argc, char* argv[]) {
     }
     
     // Modo linha de comando
-    if (argc < 4) {
+    vector<string> args(argv, argv + argc);
+    
+    // Opcoes nomeadas
+    string valor;
+    if (extrairOpcao(args, "--lote", valor)) {
+        if (!semOpcoesRestantes(args)) {
+            return 1;
+        }
+        ManifestoLote manifesto;
+        string erro;
+        if (!ExecutorLote::lerManifesto(valor, manifesto, erro)) {
+            cout << "Manifesto invalido: " << erro << endl;
+            return 1;
+        }
+        return ExecutorLote::executar(manifesto);
+    }
+    if (extrairOpcao(args, "--servico", valor)) {
+        ConfiguracaoServico config;
+        config.socket = valor;
+        const int MAXIMO = numeric_limits<int>::max();
+        if (!extrairNumero(args, "--trabalhadores", 0, MAXIMO, config.trabalhadores) ||
+            !extrairNumero(args, "--max-grafos", 1, MAXIMO, config.maxGrafos)) {
+            return 1;
+        }
+        config.usarCache = !extrairFlag(args, "--sem-cache");
+        config.calcularLimite = !extrairFlag(args, "--sem-limite");
+        if (!semOpcoesRestantes(args)) {
+            return 1;
+        }
+        ServicoColoracao servico(config);
+        return servico.servir();
+    }
+    const int MAXIMO = numeric_limits<int>::max();
+    int numThreads = 1;
+    if (!extrairNumero(args, "--threads", 1, MAXIMO, numThreads)) {
+        return 1;
+    }
+    bool usarCache = !extrairFlag(args, "--sem-cache");
+    bool usarBits = !extrairFlag(args, "--sem-bits");
+    bool externo = extrairFlag(args, "--externo");
+    bool silencioso = extrairFlag(args, "--silencioso");
+    bool calcularLimite = !extrairFlag(args, "--sem-limite");
+    bool componentes = extrairFlag(args, "--componentes");
+    bool podar = extrairFlag(args, "--podar");
+    string arquivoSolucao;
+    extrairOpcao(args, "--salvar-solucao", arquivoSolucao);
+    Construcao construcao = CONSTRUCAO_GRAU;
+    if (extrairOpcao(args, "--construcao", valor) &&
+        !ColoracaoDefeituosa::lerConstrucao(valor, construcao)) {
+        cout << "Construcao invalida: " << valor << endl;
+        imprimirUso();
+        return 1;
+    }
+    Reordenacao reordenacao = REORDENACAO_NENHUMA;
+    if (extrairOpcao(args, "--reordenar", valor) && !Grafo::lerReordenacao(valor, reordenacao)) {
+        cout << "Reordenacao invalida: " << valor << endl;
+        imprimirUso();
+        return 1;
+    }
+    int iteracoesBuscaLocal = 0;
+    int tamanhoElite = 0;
+    CriterioParada criterio; // 0 desliga cada critério
+    if (!extrairNumero(args, "--busca-local", 0, MAXIMO, iteracoesBuscaLocal) ||
+        !extrairNumero(args, "--elite", 0, MAXIMO, tamanhoElite) ||
+        !extrairNumero(args, "--tempo", 0.0, numeric_limits<double>::max(), criterio.tempoLimite) ||
+        !extrairNumero(args, "--alvo", 0, MAXIMO, criterio.alvoCores) ||
+        !extrairNumero(args, "--limite-inferior", 0, MAXIMO, criterio.limiteInferior) ||
+        !extrairNumero(args, "--estagnacao", 0, MAXIMO, criterio.iteracoesSemMelhora)) {
+        return 1;
+    }
+    if (!semOpcoesRestantes(args)) {
+        imprimirUso();
+        return 1;
+    }
+    
+    if (args.size() < 4) {
         imprimirUso();
         return 1;
     }
     
-    string arquivoInstancia = argv[1];
-    int d = atoi(argv[2]);
-    string algoritmo = argv[3];
+    string arquivoInstancia = args[1];
+    int d = 0;
+    if (!lerNumero("d", args[2], 0, MAXIMO, d)) {
+        return 1;
+    }
+    string algoritmo = args[3];
     
     // Lê grafo do arquivo
     cout << "Lendo instancia: " << arquivoInstancia << endl;
-    Grafo* g = Grafo::lerArquivo(arquivoInstancia);
+    RelatorioLeitura relatorio;
+    Grafo* g;
+    ContadoresInstrumentacao leitura; // tempo de leitura (-DINSTRUMENTACAO)
+    {
+        INSTR_ESCOPO(leitura);
+        INSTR_FASE(FASE_LEITURA);
+        if (externo) {
+            // As arestas ficam no cache mapeado; so o estado por vertice vai para a memoria
+            if (!usarCache) {
+                cerr << "Aviso: --externo usa o cache binario; --sem-cache ignorado" << endl;
+            }
+            g = CacheGrafo::carregarExterno(arquivoInstancia, relatorio);
+        } else {
+            g = Grafo::lerArquivo(arquivoInstancia, relatorio, usarCache);
+        }
+    }
+    
+    if (relatorio.temProblemas()) {
+        relatorio.imprimir(cerr, arquivoInstancia);
+    }
     
     if (g == nullptr) {
         cerr << "Erro ao carregar instancia!" << endl;
@@ -143,79 +353,181 @@ int main(int argc, char* argv[]) {
     }
     
     cout << "Grafo carregado: " << g->getNumVertices() << " vertices, " 
-         << g->getNumArestas() << " arestas" << endl;
+         << g->getNumArestas() << " arestas"
+         << (relatorio.lidoDoCache ? " (cache binario)" : "") << endl;
+    if (externo) {
+        cout << "Modo semi-externo: arestas mapeadas de " << CacheGrafo::caminhoCache(arquivoInstancia)
+             << endl;
+    }
+    
+    // Renumeração dos vértices; as cores são relatadas nos identificadores originais
+    vector<int> rotulos;
+    if (reordenacao != REORDENACAO_NENHUMA && externo) {
+        cerr << "Aviso: --reordenar nao se aplica ao modo semi-externo; ignorado" << endl;
+        reordenacao = REORDENACAO_NENHUMA;
+    }
+    if (reordenacao != REORDENACAO_NENHUMA) {
+        auto inicio = chrono::high_resolution_clock::now();
+        rotulos = g->ordemReordenacao(reordenacao);
+        Grafo* reordenado = g->reordenar(rotulos);
+        delete g;
+        g = reordenado;
+        double segundos = chrono::duration<double>(chrono::high_resolution_clock::now() - inicio).count();
+        cout << "Reordenacao " << Grafo::nomeReordenacao(reordenacao) << ": " << segundos << " s" << endl;
+    }
+    if (!usarBits) {
+        g->usarMatrizBits(false);
+    }
+    if (g->temMatrizBits()) {
+        cout << "Grafo denso (densidade " << g->getDensidade() << "): matriz de bits, kernel "
+             << KernelBits::implementacao() << endl;
+    }
     cout << "Parametro d: " << d << endl;
     
     ColoracaoDefeituosa coloracao(*g, d);
+    INSTR_ACUMULAR(coloracao.getInstrumentacao(), leitura);
+    coloracao.setBuscaLocal(iteracoesBuscaLocal);
+    if (iteracoesBuscaLocal > 0) {
+        cout << "Busca local: " << iteracoesBuscaLocal << " iteracoes tabu por tentativa" << endl;
+    }
+    coloracao.setElite(tamanhoElite);
+    if (tamanhoElite > 0) {
+        cout << "Elite: " << tamanhoElite << " solucoes (religacao de caminhos)" << endl;
+    }
+    coloracao.setCriterioParada(criterio);
+    if (calcularLimite) {
+        LimiteInferior limite(*g);
+        coloracao.setLimiteInferior(limite.limite(d));
+        cout << "Limite inferior calculado: " << limite.descrever(d) << endl;
+    }
+    coloracao.setConstrucao(construcao);
+    coloracao.setSilencioso(silencioso);
+    coloracao.setReordenacao(reordenacao, rotulos);
+    if ((componentes || podar) && externo) {
+        cerr << "Aviso: --componentes e --podar nao se aplicam ao modo semi-externo; ignorados" << endl;
+    } else {
+        coloracao.setDecomposicao(componentes, podar);
+    }
+    if (podar && !calcularLimite) {
+        cerr << "Aviso: sem o limite inferior, --podar retira apenas vertices isolados" << endl;
+    }
+    if (construcao != CONSTRUCAO_GRAU) {
+        cout << "Construcao: " << ColoracaoDefeituosa::nomeConstrucao(construcao) << endl;
+    }
     
     // Inicializa semente de randomizacao
     unsigned int semente;
     
     if (algoritmo == "guloso") {
         semente = time(0);
-        srand(semente);
+        coloracao.setSemente(semente);
         cout << "Semente: " << semente << endl;
         
         cout << "\n--- EXECUTANDO ALGORITMO GULOSO ---" << endl;
-        Solucao sol = coloracao.algoritmoGuloso();
+        Solucao sol = externo ? coloracao.algoritmoGulosoExterno() : coloracao.algoritmoGuloso();
         coloracao.imprimirSolucao(sol);
-        coloracao.salvarCSV(sol, arquivoInstancia, "Guloso", -1, 0, 0, semente);
+        coloracao.salvarCSV(sol, arquivoInstancia, externo ? "GulosoExterno" : "Guloso",
+                            -1, 0, 0, semente);
+        salvarSolucao(coloracao, sol, arquivoSolucao);
+        if (externo) {
+            imprimirMemoria();
+        }
+        
+    } else if (algoritmo == "dsatur" || algoritmo == "smallestlast") {
+        semente = time(0);
+        coloracao.setSemente(semente);
+        coloracao.setConstrucao(algoritmo == "dsatur" ? CONSTRUCAO_DSATUR : CONSTRUCAO_SMALLEST_LAST);
+        cout << "Semente: " << semente << endl;
+        
+        Solucao sol;
+        if (algoritmo == "dsatur") {
+            cout << "\n--- EXECUTANDO ALGORITMO DSATUR ---" << endl;
+            sol = coloracao.algoritmoDSatur();
+        } else {
+            cout << "\n--- EXECUTANDO ALGORITMO SMALLEST-LAST ---" << endl;
+            sol = coloracao.algoritmoSmallestLast();
+        }
+        coloracao.imprimirSolucao(sol);
+        coloracao.salvarCSV(sol, arquivoInstancia, algoritmo == "dsatur" ? "DSATUR" : "SmallestLast",
+                            -1, 0, 0, semente);
+        salvarSolucao(coloracao, sol, arquivoSolucao);
+        if (externo) {
+            imprimirMemoria();
+        }
         
     } else if (algoritmo == "grasp") {
-        if (argc < 6) {
+        if (args.size() < 6) {
             cout << "Parametros insuficientes para GRASP!" << endl;
             imprimirUso();
             delete g;
             return 1;
         }
         
-        double alpha = atof(argv[4]);
-        int numIteracoes = atoi(argv[5]);
-        
-        // Semente opcional
-        if (argc >= 7) {
-            semente = atoi(argv[6]);
-        } else {
-            semente = time(0);
+        double alpha = 0.0;
+        int numIteracoes = 0;
+        semente = time(0); // semente opcional
+        if (!lerNumero("alpha", args[4], 0.0, 1.0, alpha) ||
+            !lerNumero("numIteracoes", args[5], 1, MAXIMO, numIteracoes) ||
+            (args.size() >= 7 &&
+             !lerNumero("semente", args[6], 0u, numeric_limits<unsigned int>::max(), semente))) {
+            delete g;
+            return 1;
         }
-        srand(semente);
+        coloracao.setSemente(semente);
+        coloracao.setNumThreads(numThreads);
         
         cout << "Semente: " << semente << endl;
         cout << "Alpha: " << alpha << endl;
         cout << "Numero de iteracoes: " << numIteracoes << endl;
+        if (numThreads > 1) {
+            cout << "Threads: " << numThreads << endl;
+        }
         
         cout << "\n--- EXECUTANDO ALGORITMO GRASP ---" << endl;
         Solucao sol = coloracao.algoritmoRandomizado(numIteracoes, alpha);
         coloracao.imprimirSolucao(sol);
         coloracao.salvarCSV(sol, arquivoInstancia, "GRASP", alpha, numIteracoes, 0, semente);
+        salvarSolucao(coloracao, sol, arquivoSolucao);
+        if (externo) {
+            imprimirMemoria();
+        }
         
     } else if (algoritmo == "reativo") {
-        if (argc < 6) {
+        if (args.size() < 6) {
             cout << "Parametros insuficientes para Reativo!" << endl;
             imprimirUso();
             delete g;
             return 1;
         }
         
-        int numIteracoes = atoi(argv[4]);
-        int tamBloco = atoi(argv[5]);
-        
-        // Semente opcional
-        if (argc >= 7) {
-            semente = atoi(argv[6]);
-        } else {
-            semente = time(0);
+        int numIteracoes = 0;
+        int tamBloco = 0;
+        semente = time(0); // semente opcional
+        if (!lerNumero("numIteracoes", args[4], 1, MAXIMO, numIteracoes) ||
+            !lerNumero("tamanhoBloco", args[5], 1, MAXIMO, tamBloco) ||
+            (args.size() >= 7 &&
+             !lerNumero("semente", args[6], 0u, numeric_limits<unsigned int>::max(), semente))) {
+            delete g;
+            return 1;
         }
-        srand(semente);
+        coloracao.setSemente(semente);
+        coloracao.setNumThreads(numThreads);
         
         cout << "Semente: " << semente << endl;
         cout << "Numero de iteracoes: " << numIteracoes << endl;
         cout << "Tamanho do bloco: " << tamBloco << endl;
+        if (numThreads > 1) {
+            cout << "Threads: " << numThreads << endl;
+        }
         
         cout << "\n--- EXECUTANDO ALGORITMO REATIVO ---" << endl;
         Solucao sol = coloracao.algoritmoReativo(numIteracoes, tamBloco);
         coloracao.imprimirSolucao(sol);
         coloracao.salvarCSV(sol, arquivoInstancia, "Reativo", -1, numIteracoes, tamBloco, semente);
+        salvarSolucao(coloracao, sol, arquivoSolucao);
+        if (externo) {
+            imprimirMemoria();
+        }
         
     } else {
         cout << "Algoritmo invalido: " << algoritmo << endl;